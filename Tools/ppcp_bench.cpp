@@ -0,0 +1,440 @@
+/*********************************************************************
+ * \file   ppcp_bench.cpp
+ * \brief  runs the book/ppcp kernels by name, one json line per run
+ *         sizes, threads, schedule, value type, pinning and repetitions
+ *         come from the command line instead of a recompile.
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef __linux__
+    #include <sched.h>
+#endif
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/fmt/ranges.h>
+
+#include "false_sharing.hpp"
+#include "fibonacci.hpp"
+#include "matvec.hpp"
+#include "matvec_fixed.hpp"
+#include "matvec_precision.hpp"
+
+struct options_t {
+    std::string kernel;
+    std::string schedule;
+    std::string type;
+    std::string pin     = "none";
+    uint64_t    m       = 0;
+    uint64_t    n       = 0;
+    uint64_t    threads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t    chunk   = 16;
+    uint64_t    reps    = 5;
+    uint64_t    warmup  = 1;
+};
+
+// warmup runs are not reported, every measured run prints one json line
+template <typename func_t>
+void repeat(const options_t &opt, uint64_t threads, double work, const char *unit, func_t &&func)
+{
+    for (uint64_t rep = 0; rep < opt.warmup + opt.reps; rep++) {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+
+        if (rep < opt.warmup)
+            continue;
+
+        fmt::print("{{\"kernel\":\"{}\",\"schedule\":\"{}\",\"type\":\"{}\",\"m\":{},\"n\":{},\"threads\":{},"
+                   "\"chunk\":{},\"pin\":\"{}\",\"rep\":{},\"seconds\":{:.9f},\"work\":{},\"unit\":\"{}\","
+                   "\"rate\":{:.6e}}}\n",
+                   opt.kernel, opt.schedule, opt.type, opt.m, opt.n, threads, opt.chunk, opt.pin,
+                   rep - opt.warmup, delta.count(), work, unit, work / delta.count());
+        std::fflush(stdout);
+    }
+}
+
+//
+// kernels, all sizes and policies from the options
+//
+
+template <typename value_t>
+void bench_matvec(const options_t &opt)
+{
+    std::vector<value_t> A(opt.m * opt.n);
+    std::vector<value_t> x(opt.n);
+    std::vector<value_t> b(opt.m);
+    init(A, x, opt.m, opt.n);
+
+    const double bytes = double(sizeof(value_t)) * opt.m * opt.n;
+
+    if (opt.schedule == "sequential")
+        repeat(opt, 1, bytes, "bytes", [&] { sequential_mult(A, x, b, opt.m, opt.n); });
+    else if (opt.schedule == "block")
+        repeat(opt, opt.threads, bytes, "bytes", [&] { block_parallel_mult(A, x, b, opt.m, opt.n, opt.threads); });
+    else if (opt.schedule == "cyclic")
+        repeat(opt, opt.threads, bytes, "bytes", [&] { cyclic_parallel_mult(A, x, b, opt.m, opt.n, opt.threads); });
+    else
+        repeat(opt, opt.threads, bytes, "bytes",
+               [&] { dynamic_parallel_mult(A, x, b, opt.m, opt.n, opt.threads, opt.chunk); });
+}
+
+// m independent n x n problems, one after the other: small-matrix latency
+template <typename value_t>
+void bench_batched(const options_t &opt)
+{
+    std::vector<value_t> A(opt.m * opt.n * opt.n);
+    std::vector<value_t> x(opt.m * opt.n);
+    std::vector<value_t> b(opt.m * opt.n);
+    init(A, x, opt.m * opt.n, opt.n); // the A_i as one tall matrix, only x_0 is set: timing only
+
+    const auto kernel = opt.schedule == "fixed" ? select_rows_kernel<value_t, uint64_t>(opt.n)
+                                                : generic_rows_mult<value_t, uint64_t>;
+
+    repeat(opt, 1, double(opt.m), "matvecs", [&] { batched_mult(kernel, A, x, b, opt.m, opt.n, opt.n); });
+}
+
+template <typename value_t>
+void bench_transposed(const options_t &opt)
+{
+    std::vector<value_t> A(opt.m * opt.n);
+    std::vector<value_t> x(opt.m);
+    std::vector<value_t> b(opt.n);
+    init(A, x, opt.m, opt.n);
+
+    const double bytes = double(sizeof(value_t)) * opt.m * opt.n;
+
+    if (opt.kernel == "transposed_sequential")
+        repeat(opt, 1, bytes, "bytes", [&] { sequential_transposed_mult(A, x, b, opt.m, opt.n); });
+    else if (opt.kernel == "transposed_atomic")
+        repeat(opt, opt.threads, bytes, "bytes", [&] { atomic_transposed_mult(A, x, b, opt.m, opt.n, opt.threads); });
+    else
+        repeat(opt, opt.threads, bytes, "bytes", [&] { private_transposed_mult(A, x, b, opt.m, opt.n, opt.threads); });
+}
+
+template <typename accum_t, typename value_t>
+void bench_precision(const options_t &opt)
+{
+    std::vector<value_t> A(opt.m * opt.n);
+    std::vector<value_t> x(opt.n);
+    std::vector<double>  b(opt.m);
+    init(A, x, opt.m, opt.n);
+
+    repeat(opt, opt.threads, double(sizeof(value_t)) * opt.m * opt.n, "bytes",
+           [&] { precision_block_parallel_mult<accum_t>(A, x, b, opt.m, opt.n, opt.threads); });
+}
+
+void bench_false_sharing(const options_t &opt)
+{
+    // packed: 8 counters per line, padded: one line per counter
+    const uint64_t stride = opt.kernel == "false_sharing_packed" ? 1 : CACHE_LINE_SIZE / sizeof(uint64_t);
+
+    std::vector<uint64_t> counters;
+    repeat(opt, opt.threads, double(opt.threads) * opt.n, "increments",
+           [&] { strided_increment(counters, opt.threads, stride, opt.n); });
+}
+
+template <typename value_t>
+void bench_fibonacci_fan_out(const options_t &opt)
+{
+    if (opt.n > uint64_t(INT32_MAX))
+        throw std::invalid_argument("fibonacci_fan_out: n must fit an int");
+
+    repeat(opt, opt.threads, double(opt.threads) * opt.n, "additions",
+           [&] { fibonacci_fan_out<value_t>(int(opt.n), int(opt.threads)); });
+}
+
+void bench_fast_fibonacci(const options_t &opt)
+{
+    const unsigned depth = big_uint_t::parallel_depth(unsigned(opt.threads), fibonacci_limbs(opt.n / 2));
+
+    repeat(opt, opt.threads, double(opt.n), "terms", [&] { fast_fibonacci(opt.n, depth); });
+}
+
+//
+// kernel table: first schedule and type are the defaults
+//
+
+template <typename value_t>
+struct type_tag {
+    using type = value_t;
+};
+
+template <typename func_t>
+void visit_type(const std::string &type, func_t &&func)
+{
+    if (type == "u32")
+        func(type_tag<uint32_t>{});
+    else if (type == "u64")
+        func(type_tag<uint64_t>{});
+    else if (type == "f32")
+        func(type_tag<float>{});
+    else if (type == "f64")
+        func(type_tag<double>{});
+    else
+        func(type_tag<bfloat16_t>{});
+}
+
+// every arithmetic type for the integer-safe kernels, the precision kernels are floating point only
+template <template <typename> typename bench_t, bool precision = false>
+void run_typed(const options_t &opt)
+{
+    visit_type(opt.type, [&](auto tag) {
+        using value_t = typename decltype(tag)::type;
+
+        if constexpr (precision ? !std::is_integral_v<value_t> : std::is_arithmetic_v<value_t>)
+            bench_t<value_t>::run(opt);
+    });
+}
+
+template <typename value_t>
+struct matvec_bench {
+    static void run(const options_t &opt) { bench_matvec<value_t>(opt); }
+};
+
+template <typename value_t>
+struct batched_bench {
+    static void run(const options_t &opt) { bench_batched<value_t>(opt); }
+};
+
+template <typename value_t>
+struct transposed_bench {
+    static void run(const options_t &opt) { bench_transposed<value_t>(opt); }
+};
+
+template <typename accum_t>
+struct precision_bench {
+    template <typename value_t>
+    struct with {
+        static void run(const options_t &opt) { bench_precision<accum_t, value_t>(opt); }
+    };
+};
+
+template <typename value_t>
+struct fan_out_bench {
+    static void run(const options_t &opt) { bench_fibonacci_fan_out<value_t>(opt); }
+};
+
+struct kernel_t {
+    const char                            *name;
+    std::vector<std::string>               schedules;
+    std::vector<std::string>               types;
+    uint64_t                               m;
+    uint64_t                               n;
+    std::function<void(const options_t &)> run;
+};
+
+const std::vector<kernel_t> &kernels()
+{
+    const std::vector<std::string> arithmetic = {"u64", "u32", "f32", "f64"};
+    const std::vector<std::string> floating = {"f32", "f64", "bf16"};
+    const std::vector<std::string> counter  = {"u64"};
+    const std::vector<std::string> big      = {"big_uint"};
+
+    static const std::vector<kernel_t> table = {
+        {"matvec", {"block", "cyclic", "dynamic", "sequential"}, arithmetic, 1UL << 13, 1UL << 13,
+         run_typed<matvec_bench>},
+        {"matvec_batched", {"fixed", "generic"}, arithmetic, 1UL << 12, 64, run_typed<batched_bench>},
+        {"transposed_sequential", {"sequential"}, arithmetic, 1UL << 13, 1UL << 13, run_typed<transposed_bench>},
+        {"transposed_atomic", {"block"}, arithmetic, 1UL << 13, 1UL << 13, run_typed<transposed_bench>},
+        {"transposed_private", {"block"}, arithmetic, 1UL << 13, 1UL << 13, run_typed<transposed_bench>},
+        {"matvec_plain", {"block"}, floating, 1UL << 11, 1UL << 15,
+         run_typed<precision_bench<plain_accum>::with, true>},
+        {"matvec_wide", {"block"}, floating, 1UL << 11, 1UL << 15, run_typed<precision_bench<wide_accum>::with, true>},
+        {"matvec_kahan", {"block"}, floating, 1UL << 11, 1UL << 15,
+         run_typed<precision_bench<kahan_accum>::with, true>},
+        {"matvec_pairwise", {"block"}, floating, 1UL << 11, 1UL << 15,
+         run_typed<precision_bench<pairwise_accum>::with, true>},
+        {"false_sharing_packed", {"static"}, counter, 0, 1UL << 26, bench_false_sharing},
+        {"false_sharing_padded", {"static"}, counter, 0, 1UL << 26, bench_false_sharing},
+        {"fibonacci_fan_out", {"static"}, arithmetic, 0, 1UL << 26, run_typed<fan_out_bench>},
+        {"fast_fibonacci", {"fork"}, big, 0, 1000000, bench_fast_fibonacci},
+    };
+
+    return table;
+}
+
+//
+// pinning: the process cpu set is narrowed before the kernel spawns its threads, they inherit it.
+//  compact -> the first threads cpus, scatter -> threads cpus spread over all of them
+//
+
+void pin_threads(const std::string &pin, uint64_t threads)
+{
+    if (pin == "none")
+        return;
+
+#ifdef __linux__
+    cpu_set_t available;
+    if (sched_getaffinity(0, sizeof(available), &available) != 0)
+        throw std::runtime_error("pin: sched_getaffinity failed");
+
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        if (CPU_ISSET(cpu, &available))
+            cpus.push_back(cpu);
+
+    const uint64_t count = std::min<uint64_t>(threads, cpus.size());
+
+    cpu_set_t chosen;
+    CPU_ZERO(&chosen);
+    for (uint64_t i = 0; i < count; i++)
+        CPU_SET(cpus[pin == "compact" ? i : i * cpus.size() / count], &chosen);
+
+    if (sched_setaffinity(0, sizeof(chosen), &chosen) != 0)
+        throw std::runtime_error("pin: sched_setaffinity failed");
+#else
+    throw std::invalid_argument("pin: cpu sets are linux only");
+#endif
+}
+
+//
+// command line
+//
+
+void usage(std::FILE *out)
+{
+    fmt::print(out,
+               "usage: ppcp-bench --kernel NAME [options]\n"
+               "  --kernel NAME      kernel to run, see below\n"
+               "  --m ROWS           matrix rows\n"
+               "  --n COLS           matrix columns, increments per thread, fibonacci index\n"
+               "  --threads T        worker threads (hardware threads)\n"
+               "  --schedule S       scheduling policy of the kernel (first listed)\n"
+               "  --chunk C          rows per grab of the dynamic schedule (16)\n"
+               "  --type T           value type of the kernel (first listed)\n"
+               "  --pin P            none, compact or scatter cpu set (none)\n"
+               "  --reps R           measured repetitions (5)\n"
+               "  --warmup W         unreported runs before them (1)\n"
+               "kernels:\n");
+
+    for (const auto &kernel : kernels())
+        fmt::print(out, "  {:<22} schedule {:<30} type {:<16} m {:>5} n {}\n", kernel.name,
+                   fmt::format("{}", fmt::join(kernel.schedules, "|")), fmt::format("{}", fmt::join(kernel.types, "|")),
+                   kernel.m, kernel.n);
+}
+
+uint64_t parse_count(const std::string &name, const std::string &value)
+{
+    size_t   used  = 0;
+    uint64_t count = 0;
+    try {
+        count = std::stoull(value, &used, 0);
+    }
+    catch (const std::exception &) {
+    }
+
+    if (used == 0 || used != value.size() || value[0] == '-')
+        throw std::invalid_argument(name + ": not a count: " + value);
+    return count;
+}
+
+const kernel_t &parse(int argc, char *argv[], options_t &opt)
+{
+    bool has_m = false, has_n = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string name = argv[i], value;
+
+        // --name=value and --name value
+        const auto equal = name.find('=');
+        if (equal != std::string::npos) {
+            value = name.substr(equal + 1);
+            name.resize(equal);
+        }
+        else if (name == "--help" || name == "-h") {
+            usage(stdout);
+            std::exit(0);
+        }
+        else if (i + 1 < argc) {
+            value = argv[++i];
+        }
+        else {
+            throw std::invalid_argument(name + ": missing value");
+        }
+
+        if (name == "--kernel")
+            opt.kernel = value;
+        else if (name == "--schedule")
+            opt.schedule = value;
+        else if (name == "--type")
+            opt.type = value;
+        else if (name == "--pin")
+            opt.pin = value;
+        else if (name == "--m")
+            opt.m = parse_count(name, value), has_m = true;
+        else if (name == "--n")
+            opt.n = parse_count(name, value), has_n = true;
+        else if (name == "--threads")
+            opt.threads = parse_count(name, value);
+        else if (name == "--chunk")
+            opt.chunk = parse_count(name, value);
+        else if (name == "--reps")
+            opt.reps = parse_count(name, value);
+        else if (name == "--warmup")
+            opt.warmup = parse_count(name, value);
+        else
+            throw std::invalid_argument(name + ": unknown option");
+    }
+
+    if (opt.kernel.empty())
+        throw std::invalid_argument("--kernel is required");
+
+    const auto &table  = kernels();
+    const auto  kernel = std::find_if(table.begin(), table.end(), [&](auto &entry) { return opt.kernel == entry.name; });
+    if (kernel == table.end())
+        throw std::invalid_argument("--kernel: unknown kernel: " + opt.kernel);
+
+    auto pick = [](std::string &value, const std::vector<std::string> &choices, const char *name) {
+        if (value.empty())
+            value = choices.front();
+        else if (std::find(choices.begin(), choices.end(), value) == choices.end())
+            throw std::invalid_argument(std::string(name) + ": not supported by the kernel: " + value);
+    };
+    pick(opt.schedule, kernel->schedules, "--schedule");
+    pick(opt.type, kernel->types, "--type");
+
+    if (opt.pin != "none" && opt.pin != "compact" && opt.pin != "scatter")
+        throw std::invalid_argument("--pin: none, compact or scatter: " + opt.pin);
+    if (opt.threads == 0 || opt.chunk == 0)
+        throw std::invalid_argument("--threads and --chunk must be positive");
+
+    opt.m = has_m ? opt.m : kernel->m;
+    opt.n = has_n ? opt.n : kernel->n;
+    return *kernel;
+}
+
+int main(int argc, char *argv[])
+{
+    options_t opt;
+
+    try {
+        const kernel_t &kernel = parse(argc, argv, opt);
+
+        pin_threads(opt.pin, opt.threads);
+        kernel.run(opt);
+    }
+    catch (const std::invalid_argument &error) {
+        fmt::print(stderr, "ppcp-bench: {}\n\n", error.what());
+        usage(stderr);
+        return 2;
+    }
+    catch (const std::exception &error) {
+        fmt::print(stderr, "ppcp-bench: {}\n", error.what());
+        return 1;
+    }
+
+    return 0;
+}
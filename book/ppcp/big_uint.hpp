@@ -0,0 +1,449 @@
+/*********************************************************************
+ * \file   big_uint.hpp
+ * \brief  arbitrary-precision unsigned integer
+ *         schoolbook -> karatsuba -> toom-3 multiplication,
+ *         large sub-products are forked with std::async.
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace big_uint_detail
+{
+
+using limb_t  = uint32_t;
+using dlimb_t = uint64_t;
+using limbs_t = std::vector<limb_t>;
+
+// operand sizes (in limbs) at which the next algorithm takes over
+constexpr size_t KARATSUBA_THRESHOLD = 48;
+constexpr size_t TOOM3_THRESHOLD     = 384;
+
+// sub-products smaller than this (na + nb limbs) are never forked
+constexpr size_t PARALLEL_THRESHOLD = 4096;
+
+inline size_t significant(const limb_t *a, size_t na)
+{
+    while (na != 0 && a[na - 1] == 0)
+        na--;
+    return na;
+}
+
+inline void trim(limbs_t &a)
+{
+    a.resize(significant(a.data(), a.size()));
+}
+
+inline int compare(const limb_t *a, size_t na, const limb_t *b, size_t nb)
+{
+    na = significant(a, na);
+    nb = significant(b, nb);
+
+    if (na != nb)
+        return na < nb ? -1 : 1;
+
+    for (size_t i = na; i-- != 0;) {
+        if (a[i] != b[i])
+            return a[i] < b[i] ? -1 : 1;
+    }
+
+    return 0;
+}
+
+// r += a * base^shift
+inline void add_shifted(limbs_t &r, const limb_t *a, size_t na, size_t shift)
+{
+    if (r.size() < na + shift)
+        r.resize(na + shift, 0);
+
+    dlimb_t carry = 0;
+    size_t  i     = shift;
+
+    for (size_t j = 0; j < na; j++, i++) {
+        carry += dlimb_t(r[i]) + a[j];
+        r[i] = limb_t(carry);
+        carry >>= 32;
+    }
+
+    for (; carry != 0; i++) {
+        if (i == r.size())
+            r.push_back(0);
+        carry += r[i];
+        r[i] = limb_t(carry);
+        carry >>= 32;
+    }
+}
+
+// a -= b, requires a >= b
+inline void sub_in_place(limbs_t &a, const limb_t *b, size_t nb)
+{
+    nb = significant(b, nb);
+    assert(compare(a.data(), a.size(), b, nb) >= 0);
+
+    int64_t borrow = 0;
+    size_t  i      = 0;
+
+    for (; i < nb; i++) {
+        int64_t diff = int64_t(a[i]) - b[i] - borrow;
+        borrow       = diff < 0;
+        a[i]         = limb_t(diff + (borrow << 32));
+    }
+
+    for (; borrow != 0; i++) {
+        borrow = a[i] == 0;
+        a[i]--;
+    }
+
+    trim(a);
+}
+
+inline limbs_t add(const limb_t *a, size_t na, const limb_t *b, size_t nb)
+{
+    limbs_t r(a, a + na);
+    add_shifted(r, b, nb, 0);
+    return r;
+}
+
+inline limbs_t schoolbook_mult(const limb_t *a, size_t na, const limb_t *b, size_t nb)
+{
+    limbs_t r(na + nb, 0);
+
+    for (size_t i = 0; i < na; i++) {
+        dlimb_t carry = 0;
+        for (size_t j = 0; j < nb; j++) {
+            carry += dlimb_t(a[i]) * b[j] + r[i + j];
+            r[i + j] = limb_t(carry);
+            carry >>= 32;
+        }
+        r[i + nb] = limb_t(carry);
+    }
+
+    trim(r);
+    return r;
+}
+
+inline limbs_t mult(const limb_t *a, size_t na, const limb_t *b, size_t nb, unsigned depth);
+
+inline limbs_t mult(const limbs_t &a, const limbs_t &b, unsigned depth)
+{
+    return mult(a.data(), a.size(), b.data(), b.size(), depth);
+}
+
+// run fn on its own thread while the parallel budget lasts, inline otherwise
+template <typename func_t>
+std::future<limbs_t> fork(bool parallel, func_t &&fn)
+{
+    return std::async(parallel ? std::launch::async : std::launch::deferred, std::forward<func_t>(fn));
+}
+
+//
+// karatsuba: a*b = z2 B^2 + ((a0+a1)(b0+b1) - z0 - z2) B + z0
+//
+
+inline limbs_t karatsuba_mult(const limb_t *a, size_t na, const limb_t *b, size_t nb, unsigned depth)
+{
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+
+    const size_t k        = na / 2;
+    const bool   parallel = depth != 0 && na + nb >= PARALLEL_THRESHOLD;
+    const auto   next     = parallel ? depth - 1 : depth;
+
+    // unbalanced: b fits into the lower half, split a only
+    if (nb <= k) {
+        auto hi = fork(parallel, [=] { return mult(a + k, na - k, b, nb, next); });
+        auto r  = mult(a, k, b, nb, next);
+        auto z  = hi.get();
+        add_shifted(r, z.data(), z.size(), k);
+        trim(r);
+        return r;
+    }
+
+    auto f0 = fork(parallel, [=] { return mult(a, k, b, k, next); });
+    auto f2 = fork(parallel, [=] { return mult(a + k, na - k, b + k, nb - k, next); });
+
+    const auto sa = add(a, k, a + k, na - k);
+    const auto sb = add(b, k, b + k, nb - k);
+    auto       z1 = mult(sa, sb, next);
+
+    const auto z0 = f0.get();
+    const auto z2 = f2.get();
+
+    sub_in_place(z1, z0.data(), z0.size());
+    sub_in_place(z1, z2.data(), z2.size());
+
+    limbs_t r(z0);
+    add_shifted(r, z1.data(), z1.size(), k);
+    add_shifted(r, z2.data(), z2.size(), 2 * k);
+    trim(r);
+    return r;
+}
+
+//
+// signed magnitude, only needed for the toom-3 evaluation / interpolation
+//
+
+struct signed_t {
+    limbs_t mag;
+    bool    neg = false;
+};
+
+inline signed_t signed_add(const signed_t &x, const signed_t &y)
+{
+    if (x.neg == y.neg)
+        return {add(x.mag.data(), x.mag.size(), y.mag.data(), y.mag.size()), x.neg};
+
+    const bool x_ge = compare(x.mag.data(), x.mag.size(), y.mag.data(), y.mag.size()) >= 0;
+    signed_t   r    = x_ge ? x : y;
+    const auto &s   = x_ge ? y : x;
+
+    sub_in_place(r.mag, s.mag.data(), s.mag.size());
+    r.neg = r.mag.empty() ? false : r.neg;
+    return r;
+}
+
+inline signed_t signed_sub(const signed_t &x, signed_t y)
+{
+    y.neg = y.mag.empty() ? false : !y.neg;
+    return signed_add(x, y);
+}
+
+inline signed_t signed_shl1(signed_t x)
+{
+    limb_t carry = 0;
+    for (auto &limb : x.mag) {
+        const limb_t next = limb >> 31;
+        limb              = (limb << 1) | carry;
+        carry             = next;
+    }
+    if (carry)
+        x.mag.push_back(carry);
+    return x;
+}
+
+// x / d, the division is known to be exact
+inline signed_t signed_divexact(signed_t x, limb_t d)
+{
+    dlimb_t rem = 0;
+    for (size_t i = x.mag.size(); i-- != 0;) {
+        const dlimb_t cur = (rem << 32) | x.mag[i];
+        x.mag[i]          = limb_t(cur / d);
+        rem               = cur % d;
+    }
+    assert(rem == 0);
+    trim(x.mag);
+    return x;
+}
+
+//
+// toom-3: evaluate at 0, 1, -1, -2, inf and interpolate (bodrato's sequence)
+//
+
+inline limbs_t toom3_mult(const limb_t *a, size_t na, const limb_t *b, size_t nb, unsigned depth)
+{
+    const size_t k = (std::max(na, nb) + 2) / 3;
+
+    // both operands need three non-empty parts
+    if (std::min(na, nb) <= 2 * k)
+        return karatsuba_mult(a, na, b, nb, depth);
+
+    const bool parallel = depth != 0 && na + nb >= PARALLEL_THRESHOLD;
+    const auto next     = parallel ? depth - 1 : depth;
+
+    auto evaluate = [k](const limb_t *p, size_t np) {
+        signed_t p0{limbs_t(p, p + k)};
+        signed_t p1{limbs_t(p + k, p + 2 * k)};
+        signed_t p2{limbs_t(p + 2 * k, p + np)};
+        trim(p0.mag);
+        trim(p1.mag);
+        trim(p2.mag);
+
+        const auto p02  = signed_add(p0, p2);
+        const auto pp1  = signed_add(p02, p1);
+        const auto pm1  = signed_sub(p02, p1);
+        const auto pm2  = signed_sub(signed_shl1(signed_add(pm1, p2)), p0);
+        return std::vector<signed_t>{p0, pp1, pm1, pm2, p2};
+    };
+
+    const auto pa = evaluate(a, na);
+    const auto pb = evaluate(b, nb);
+
+    std::vector<std::future<limbs_t>> futures;
+    for (size_t i = 1; i != 5; i++)
+        futures.emplace_back(fork(parallel, [&, i] { return mult(pa[i].mag, pb[i].mag, next); }));
+
+    signed_t r0{mult(pa[0].mag, pb[0].mag, next)};
+    signed_t r1{futures[0].get(), pa[1].neg != pb[1].neg};
+    signed_t rm1{futures[1].get(), pa[2].neg != pb[2].neg};
+    signed_t rm2{futures[2].get(), pa[3].neg != pb[3].neg};
+    signed_t r4{futures[3].get()};
+
+    for (auto *r : {&r1, &rm1, &rm2})
+        r->neg = r->mag.empty() ? false : r->neg;
+
+    signed_t r3 = signed_divexact(signed_sub(rm2, r1), 3);
+    r1          = signed_divexact(signed_sub(r1, rm1), 2);
+    signed_t r2 = signed_sub(rm1, r0);
+    r3          = signed_add(signed_divexact(signed_sub(r2, r3), 2), signed_shl1(r4));
+    r2          = signed_sub(signed_add(r2, r1), r4);
+    r1          = signed_sub(r1, r3);
+
+    assert(!r1.neg && !r2.neg && !r3.neg);
+
+    limbs_t r(std::move(r0.mag));
+    add_shifted(r, r1.mag.data(), r1.mag.size(), k);
+    add_shifted(r, r2.mag.data(), r2.mag.size(), 2 * k);
+    add_shifted(r, r3.mag.data(), r3.mag.size(), 3 * k);
+    add_shifted(r, r4.mag.data(), r4.mag.size(), 4 * k);
+    trim(r);
+    return r;
+}
+
+inline limbs_t mult(const limb_t *a, size_t na, const limb_t *b, size_t nb, unsigned depth)
+{
+    na = significant(a, na);
+    nb = significant(b, nb);
+
+    const size_t n = std::min(na, nb);
+
+    if (n == 0)
+        return {};
+    if (n < KARATSUBA_THRESHOLD)
+        return schoolbook_mult(a, na, b, nb);
+    if (n < TOOM3_THRESHOLD)
+        return karatsuba_mult(a, na, b, nb, depth);
+
+    return toom3_mult(a, na, b, nb, depth);
+}
+
+} // namespace big_uint_detail
+
+class big_uint_t {
+public:
+    using limb_t  = big_uint_detail::limb_t;
+    using limbs_t = big_uint_detail::limbs_t;
+
+    big_uint_t(uint64_t value = 0)
+    {
+        for (; value != 0; value >>= 32)
+            limbs_.push_back(limb_t(value));
+    }
+
+    explicit big_uint_t(limbs_t limbs)
+        : limbs_(std::move(limbs))
+    {
+        big_uint_detail::trim(limbs_);
+    }
+
+    // each level of depth forks the independent sub-products of one split
+    static big_uint_t mult(const big_uint_t &a, const big_uint_t &b, unsigned depth = 0)
+    {
+        return big_uint_t(big_uint_detail::mult(a.limbs_, b.limbs_, depth));
+    }
+
+    // recursion depth at which the forked sub-products of a limbs x limbs product cover num_threads.
+    // follows the split mult takes: toom-3 yields five products of a third, karatsuba three of a half,
+    // and nothing forks below PARALLEL_THRESHOLD
+    static unsigned parallel_depth(unsigned num_threads, size_t limbs)
+    {
+        using namespace big_uint_detail;
+
+        unsigned depth = 0;
+        for (size_t tasks = 1; tasks < num_threads && 2 * limbs >= PARALLEL_THRESHOLD; depth++) {
+            if (limbs >= TOOM3_THRESHOLD) {
+                tasks *= 5;
+                limbs = (limbs + 2) / 3 + 1;
+            }
+            else {
+                tasks *= 3;
+                limbs = limbs - limbs / 2 + 1;
+            }
+        }
+        return depth;
+    }
+
+    // recursion depth at which the forked sub-products cover all cores
+    static unsigned default_parallel_depth(size_t limbs)
+    {
+        return parallel_depth(std::thread::hardware_concurrency(), limbs);
+    }
+
+    big_uint_t &operator+=(const big_uint_t &other)
+    {
+        big_uint_detail::add_shifted(limbs_, other.limbs_.data(), other.limbs_.size(), 0);
+        return *this;
+    }
+
+    big_uint_t &operator-=(const big_uint_t &other)
+    {
+        big_uint_detail::sub_in_place(limbs_, other.limbs_.data(), other.limbs_.size());
+        return *this;
+    }
+
+    big_uint_t &operator<<=(unsigned bits)
+    {
+        assert(bits < 32);
+        if (bits == 0)
+            return *this;
+
+        limb_t carry = 0;
+        for (auto &limb : limbs_) {
+            const limb_t next = limb >> (32 - bits);
+            limb              = (limb << bits) | carry;
+            carry             = next;
+        }
+        if (carry)
+            limbs_.push_back(carry);
+        return *this;
+    }
+
+    friend big_uint_t operator+(big_uint_t a, const big_uint_t &b) { return a += b; }
+    friend big_uint_t operator-(big_uint_t a, const big_uint_t &b) { return a -= b; }
+    friend big_uint_t operator*(const big_uint_t &a, const big_uint_t &b) { return mult(a, b); }
+
+    friend bool operator==(const big_uint_t &a, const big_uint_t &b) { return a.limbs_ == b.limbs_; }
+    friend bool operator!=(const big_uint_t &a, const big_uint_t &b) { return a.limbs_ != b.limbs_; }
+
+    const limbs_t &limbs() const { return limbs_; }
+
+    size_t bits() const
+    {
+        if (limbs_.empty())
+            return 0;
+
+        size_t bits = 32 * limbs_.size();
+        for (limb_t top = limbs_.back(); (top & 0x80000000u) == 0; top <<= 1)
+            bits--;
+        return bits;
+    }
+
+    // leading hex digits, cheap even for millions of limbs
+    std::string hex_prefix(size_t digits = 16) const
+    {
+        static const char hex[] = "0123456789abcdef";
+
+        std::string out;
+        for (size_t i = limbs_.size(); i-- != 0 && out.size() < digits + 8;) {
+            for (int shift = 28; shift >= 0; shift -= 4)
+                out.push_back(hex[(limbs_[i] >> shift) & 0xf]);
+        }
+
+        out.erase(0, std::min(out.find_first_not_of('0'), out.size()));
+        return out.empty() ? "0" : out.substr(0, digits);
+    }
+
+private:
+    limbs_t limbs_;
+};
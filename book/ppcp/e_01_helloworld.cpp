@@ -8,15 +8,19 @@
 
 #include <stdafx.h>
 
+#include <memory_resource>
 #include <thread>
 #include <vector>
 
+#include "task_allocators.hpp"
+
 TEST_CASE("e_01_helloworld")
 {
     spdlog::info("--- --- --- e_01_helloworld --- --- ---");
 
-    const size_t             num_threads = 4;
-    std::vector<std::thread> threads;
+    const size_t                  num_threads = 4;
+    arena_scope_t                 scope;
+    std::pmr::vector<std::thread> threads(scope.resource());
 
     for (size_t id = 0; id != num_threads; ++id) {
         threads.emplace_back([](auto &&id) { spdlog::info("hello from thread: {}", id); }, id);
@@ -11,38 +11,29 @@
 
 #include <thread>
 #include <future>
+#include <memory_resource>
 #include <vector>
 
-void fibonacci(int n, std::promise<int> &&result)
-{
-    int a = 0;
-    int b = 1;
-
-    for (int i = 0; i != n; ++i) {
-
-        const int tmp = a;
-
-        a = b;
-        b += tmp;
-    }
-
-    result.set_value(a);
-}
+#include "fibonacci.hpp"
+#include "task_allocators.hpp"
 
 TEST_CASE("e_02_promise_future")
 {
     spdlog::info("--- --- --- e_02_promise_future --- --- ---");
 
-    const int                     num_threads = 32;
-    std::vector<std::thread>      threads;
-    std::vector<std::future<int>> futures;
+    // the pool outlives the futures, the arena scope everything
+    const int                          num_threads = 32;
+    arena_scope_t                      scope;
+    pool_resource_t                    pool(TASK_STATE_SIZE);
+    std::pmr::vector<std::thread>      threads(scope.resource());
+    std::pmr::vector<std::future<int>> futures(scope.resource());
 
     for (int i = 0; i != num_threads; ++i) {
 
-        std::promise<int> promise;
+        std::promise<int> promise(std::allocator_arg, std::pmr::polymorphic_allocator<int>(&pool));
         futures.emplace_back(promise.get_future());
 
-        threads.emplace_back(fibonacci, i, std::move(promise));
+        threads.emplace_back(fibonacci<int>, i, std::move(promise));
     }
 
     for (auto &&future : futures) {
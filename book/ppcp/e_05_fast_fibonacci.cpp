@@ -0,0 +1,100 @@
+/*********************************************************************
+ * \file   e_05_fast_fibonacci.cpp
+ * \brief  big-number fibonacci by fast doubling
+ *         F(2k)   = F(k) * (2F(k+1) - F(k))
+ *         F(2k+1) = F(k)^2 + F(k+1)^2
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <stdafx.h>
+
+#include <random>
+
+#include "big_uint.hpp"
+#include "fibonacci.hpp"
+#include "hpc_helpers.hpp"
+
+big_uint_t random_big_uint(size_t num_limbs, std::mt19937 &engine)
+{
+    big_uint_t::limbs_t limbs(num_limbs);
+    for (auto &limb : limbs)
+        limb = engine();
+    return big_uint_t(std::move(limbs));
+}
+
+TEST_CASE("e_05_big_uint_mult")
+{
+    spdlog::info("--- --- --- e_05_big_uint_mult --- --- ---");
+
+    std::mt19937 engine(42);
+
+    // crosses schoolbook, karatsuba, toom-3 and unbalanced splits
+    for (size_t na : {7, 60, 500, 1500, 5000}) {
+        for (size_t nb : {3, 60, 700, 5000}) {
+            const auto a = random_big_uint(na, engine);
+            const auto b = random_big_uint(nb, engine);
+
+            const big_uint_t expect(
+                big_uint_detail::schoolbook_mult(a.limbs().data(), na, b.limbs().data(), nb));
+
+            CHECK(big_uint_t::mult(a, b, 0) == expect);
+            CHECK(big_uint_t::mult(a, b, 2) == expect);
+        }
+    }
+
+    // five toom-3 products per level, nothing forks below the parallel threshold
+    CHECK(big_uint_t::parallel_depth(1, 1UL << 17) == 0);
+    CHECK(big_uint_t::parallel_depth(4, 1UL << 17) == 1);
+    CHECK(big_uint_t::parallel_depth(8, 1UL << 17) == 2);
+    CHECK(big_uint_t::parallel_depth(64, 1UL << 17) == 3);
+    CHECK(big_uint_t::parallel_depth(64, 1500) == 0);
+    CHECK(fibonacci_limbs(10000000) == 216951);
+
+    // F(10^7) has ~217k limbs, the top-level multiplication of its last step
+    const size_t num_limbs = 1UL << 17;
+    const auto   a         = random_big_uint(num_limbs, engine);
+    const auto   b         = random_big_uint(num_limbs, engine);
+
+    for (unsigned depth = 0; depth <= big_uint_t::default_parallel_depth(num_limbs) + 1; ++depth) {
+        spdlog::info("parallel depth: {}", depth);
+
+        TIMERSTART(mult);
+        big_uint_t::mult(a, b, depth);
+        TIMERSTOP(mult);
+    }
+}
+
+TEST_CASE("e_05_fast_fibonacci")
+{
+    spdlog::info("--- --- --- e_05_fast_fibonacci --- --- ---");
+
+    for (uint64_t n : {0, 1, 2, 50, 93, 1000, 12345})
+        CHECK(fast_fibonacci(n, 0) == iterative_fibonacci(n));
+
+    for (uint64_t n : {1000000UL, 10000000UL}) {
+        const unsigned depth = big_uint_t::default_parallel_depth(fibonacci_limbs(n / 2));
+        spdlog::info("n: {}, parallel depth: {}", n, depth);
+
+        TIMERSTART(fast_fibonacci_sequential);
+        const auto sequential = fast_fibonacci(n, 0);
+        TIMERSTOP(fast_fibonacci_sequential);
+
+        TIMERSTART(fast_fibonacci_parallel);
+        const auto parallel = fast_fibonacci(n, depth);
+        TIMERSTOP(fast_fibonacci_parallel);
+
+        CHECK(sequential == parallel);
+        spdlog::info("F({}): {} bits, 0x{}...", n, parallel.bits(), parallel.hex_prefix());
+    }
+
+    // the iterative version is quadratic, F(10^7) would take hours
+    const uint64_t n = 1000000;
+
+    TIMERSTART(iterative_fibonacci);
+    const auto iterative = iterative_fibonacci(n);
+    TIMERSTOP(iterative_fibonacci);
+
+    CHECK(iterative == fast_fibonacci(n, big_uint_t::default_parallel_depth(fibonacci_limbs(n / 2))));
+}
@@ -0,0 +1,70 @@
+/*********************************************************************
+ * \file   e_06_transposed_mult.cpp
+ * \brief  transposed b = A^T * x on row-major storage
+ *         atomic scatter vs private partials + blocked reduction
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <stdafx.h>
+
+#include <vector>
+
+#include "hpc_helpers.hpp"
+#include "matvec.hpp"
+
+TEST_CASE("e_06_transposed_mult_check")
+{
+    spdlog::info("--- --- --- e_06_transposed_mult_check --- --- ---");
+
+    // odd shapes: partial blocks, fewer rows than threads, n not a line multiple
+    for (uint64_t m : {1, 5, 100}) {
+        for (uint64_t n : {1, 13, 100}) {
+            std::vector<uint64_t> A(m * n);
+            std::vector<uint64_t> x(m);
+
+            for (uint64_t i = 0; i < m * n; i++)
+                A[i] = i % 7;
+            for (uint64_t row = 0; row < m; row++)
+                x[row] = row + 1;
+
+            std::vector<uint64_t> expect(n), atomic(n), partial(n);
+            sequential_transposed_mult(A, x, expect, m, n);
+            atomic_transposed_mult(A, x, atomic, m, n);
+            private_transposed_mult(A, x, partial, m, n);
+
+            CHECK(atomic == expect);
+            CHECK(partial == expect);
+        }
+    }
+}
+
+TEST_CASE("e_06_transposed_mult")
+{
+    spdlog::info("--- --- --- e_06_transposed_mult --- --- ---");
+
+    const uint64_t n = (1UL << 15);
+    const uint64_t m = (1UL << 15);
+
+    TIMERSTART(overall);
+
+    std::vector<uint64_t> A(m * n);
+    std::vector<uint64_t> x(m);
+    std::vector<uint64_t> b(n);
+    init(A, x, m, n);
+
+    TIMERSTART(sequential_transposed_mult);
+    sequential_transposed_mult(A, x, b, m, n);
+    TIMERSTOP(sequential_transposed_mult);
+
+    TIMERSTART(atomic_transposed_mult);
+    atomic_transposed_mult(A, x, b, m, n);
+    TIMERSTOP(atomic_transposed_mult);
+
+    TIMERSTART(private_transposed_mult);
+    private_transposed_mult(A, x, b, m, n);
+    TIMERSTOP(private_transposed_mult);
+
+    TIMERSTOP(overall);
+}
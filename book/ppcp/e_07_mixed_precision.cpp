@@ -0,0 +1,145 @@
+/*********************************************************************
+ * \file   e_07_mixed_precision.cpp
+ * \brief  accuracy vs throughput of float / double / bfloat16 storage
+ *         under plain, wide, kahan and pairwise accumulation
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <stdafx.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "hpc_helpers.hpp"
+#include "matvec_precision.hpp"
+
+template <typename value_t, typename index_t>
+void init_random(std::vector<value_t> &A, std::vector<value_t> &x, index_t m, index_t n)
+{
+    std::mt19937                                       engine(42);
+    std::uniform_real_distribution<compute_t<value_t>> density(0, 1);
+
+    for (index_t i = 0; i < m * n; i++)
+        A[i] = value_t(density(engine));
+
+    for (index_t col = 0; col < n; col++)
+        x[col] = value_t(density(engine));
+}
+
+// a * b == p + e exactly, dekker's split needs no fma
+template <typename real_t>
+void two_product(real_t a, real_t b, real_t &p, real_t &e)
+{
+    constexpr real_t split = real_t((uint64_t(1) << (std::numeric_limits<real_t>::digits + 1) / 2) + 1);
+
+    const real_t sa = split * a, a_hi = sa - (sa - a), a_lo = a - a_hi;
+    const real_t sb = split * b, b_hi = sb - (sb - b), b_lo = b - b_hi;
+
+    p = a * b;
+    e = ((a_hi * b_hi - p) + a_hi * b_lo + a_lo * b_hi) + a_lo * b_lo;
+}
+
+// reference on the values as stored: exact products and a compensated sum (ogita, rump and oishi's
+// dot2), as if in twice the precision of long double. that is plain double on msvc, so the double
+// rows would otherwise be measured against a reference no better than the kernels
+template <typename value_t, typename index_t>
+std::vector<long double> reference_mult(std::vector<value_t> &A, std::vector<value_t> &x, index_t m, index_t n)
+{
+    std::vector<long double> b(m);
+
+    for (index_t row = 0; row < m; row++) {
+        long double sum = 0, compensation = 0;
+        for (index_t col = 0; col < n; col++) {
+            long double product, error;
+            two_product<long double>(compute_t<value_t>(A[row * n + col]), compute_t<value_t>(x[col]), product, error);
+
+            const long double next = sum + product;
+            const long double back = next - sum;
+            compensation += ((sum - (next - back)) + (product - back)) + error;
+            sum = next;
+        }
+        b[row] = sum + compensation;
+    }
+
+    return b;
+}
+
+template <typename result_t>
+double max_relative_error(const std::vector<result_t> &b, const std::vector<long double> &reference)
+{
+    long double error = 0;
+    for (size_t row = 0; row < b.size(); row++)
+        error = std::max(error, std::fabs((b[row] - reference[row]) / reference[row]));
+    return double(error);
+}
+
+template <typename accum_t, typename value_t, typename index_t>
+double measure(const char                     *label,
+               std::vector<value_t>           &A,
+               std::vector<value_t>           &x,
+               const std::vector<long double> &reference,
+               index_t                         m,
+               index_t                         n)
+{
+    std::vector<double> b(m);
+
+    const auto start = std::chrono::steady_clock::now();
+    precision_block_parallel_mult<accum_t>(A, x, b, m, n);
+    const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+
+    const double error = max_relative_error(b, reference);
+    spdlog::info("{:>10} {:>8}: {:8.3f} GB/s, max relative error {:.3e}",
+                 label,
+                 sizeof(value_t) == 2 ? "bfloat16" : (sizeof(value_t) == 4 ? "float" : "double"),
+                 sizeof(value_t) * m * n / delta.count() / 1e9,
+                 error);
+    return error;
+}
+
+template <typename value_t>
+void compare_accumulation(uint64_t m, uint64_t n)
+{
+    std::vector<value_t> A(m * n);
+    std::vector<value_t> x(n);
+    init_random(A, x, m, n);
+
+    const auto reference = reference_mult(A, x, m, n);
+
+    const double plain    = measure<plain_accum>("plain", A, x, reference, m, n);
+    const double wide     = measure<wide_accum>("wide", A, x, reference, m, n);
+    const double kahan    = measure<kahan_accum>("kahan", A, x, reference, m, n);
+    const double pairwise = measure<pairwise_accum>("pairwise", A, x, reference, m, n);
+
+    // compensated and wide accumulation must not be worse than the plain chain
+    CHECK(wide <= plain);
+    CHECK(kahan <= plain);
+    CHECK(pairwise <= plain);
+}
+
+TEST_CASE("e_07_bfloat16")
+{
+    spdlog::info("--- --- --- e_07_bfloat16 --- --- ---");
+
+    CHECK(float(bfloat16_t(1.0f)) == 1.0f);
+    CHECK(float(bfloat16_t(-2.5f)) == -2.5f);
+    CHECK(float(bfloat16_t(1.00390625f)) == 1.0f);     // tie rounds to even
+    CHECK(float(bfloat16_t(1.01171875f)) == 1.015625f); // tie rounds to even
+    CHECK(std::isnan(float(bfloat16_t(NAN))));
+}
+
+TEST_CASE("e_07_mixed_precision")
+{
+    spdlog::info("--- --- --- e_07_mixed_precision --- --- ---");
+
+    const uint64_t n = (1UL << 15);
+    const uint64_t m = (1UL << 11);
+
+    compare_accumulation<bfloat16_t>(m, n);
+    compare_accumulation<float>(m, n);
+    compare_accumulation<double>(m, n);
+}
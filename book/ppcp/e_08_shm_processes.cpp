@@ -0,0 +1,110 @@
+/*********************************************************************
+ * \file   e_08_shm_processes.cpp
+ * \brief  multi-process b = A*x over posix shared memory
+ *         a local stand-in for a distributed row partition
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <stdafx.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "hpc_helpers.hpp"
+#include "matvec.hpp"
+#include "shm_collective.hpp"
+
+TEST_CASE("e_08_shm_collective")
+{
+    spdlog::info("--- --- --- e_08_shm_collective --- --- ---");
+
+    const int        num_procs = 3;
+    std::vector<int> gathered(num_procs * 2);
+
+    shm_comm_t world(num_procs, 1024);
+
+    world.spawn([&](shm_comm_t &comm) -> void {
+        int token = comm.rank() == 1 ? 42 : 0;
+        comm.broadcast(&token, 1, 1);
+
+        const int send[2] = {comm.rank(), token};
+        comm.gather(send, gathered.data(), std::vector<size_t>(num_procs, 2), 0);
+    });
+
+    CHECK(gathered == std::vector<int>{0, 42, 1, 42, 2, 42});
+}
+
+TEST_CASE("e_08_shm_failure")
+{
+    spdlog::info("--- --- --- e_08_shm_failure --- --- ---");
+
+    // a child that throws before the first barrier, then rank 0 itself: no rank hangs, no child is left
+    for (int failing : {1, 0}) {
+        shm_comm_t world(3, 1024);
+
+        bool thrown = false;
+        try {
+            world.spawn([&](shm_comm_t &comm) -> void {
+                if (comm.rank() == failing)
+                    throw std::runtime_error("worker failed");
+
+                int token = 0;
+                comm.broadcast(&token, 1, 0);
+            });
+        }
+        catch (const std::runtime_error &) {
+            thrown = true;
+        }
+
+        CHECK(thrown);
+        CHECK(waitpid(-1, nullptr, WNOHANG) == -1);
+    }
+}
+
+TEST_CASE("e_08_shm_parallel_mult_check")
+{
+    spdlog::info("--- --- --- e_08_shm_parallel_mult_check --- --- ---");
+
+    const uint64_t n = 37;
+    const uint64_t m = 1001;
+
+    std::vector<uint64_t> A(m * n);
+    std::vector<uint64_t> x(n);
+    std::vector<uint64_t> expect(m), b(m);
+    init(A, x, m, n);
+
+    sequential_mult(A, x, expect, m, n);
+
+    for (uint64_t num_procs : {1, 3, 4}) {
+        std::fill(b.begin(), b.end(), 0);
+        shm_parallel_mult(A, x, b, m, n, num_procs, uint64_t(2));
+        CHECK(b == expect);
+    }
+}
+
+TEST_CASE("e_08_shm_parallel_mult")
+{
+    spdlog::info("--- --- --- e_08_shm_parallel_mult --- --- ---");
+
+    const uint64_t n = (1UL << 15);
+    const uint64_t m = (1UL << 15);
+
+    const uint64_t num_procs        = 2;
+    const uint64_t threads_per_proc = 4;
+
+    std::vector<uint64_t> A(m * n);
+    std::vector<uint64_t> x(n);
+    std::vector<uint64_t> b(m);
+    init(A, x, m, n);
+
+    TIMERSTART(block_parallel_mult);
+    block_parallel_mult(A, x, b, m, n, num_procs * threads_per_proc);
+    TIMERSTOP(block_parallel_mult);
+
+    // includes fork, broadcast of x and gather of b
+    TIMERSTART(shm_parallel_mult);
+    shm_parallel_mult(A, x, b, m, n, num_procs, threads_per_proc);
+    TIMERSTOP(shm_parallel_mult);
+}
@@ -0,0 +1,106 @@
+/*********************************************************************
+ * \file   e_09_incremental_mult.cpp
+ * \brief  incremental b = A*x under sparse edits of A and x
+ *         latency vs full recomputation per change rate
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <stdafx.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "hpc_helpers.hpp"
+#include "matvec.hpp"
+#include "matvec_incremental.hpp"
+
+// rewrites rate * m rows of A and rate * n entries of x
+template <typename value_t, typename index_t>
+void random_edits(incremental_mult_t<value_t, index_t> &engine,
+                  index_t                               m,
+                  index_t                               n,
+                  double                                rate,
+                  std::mt19937                         &rng)
+{
+    std::uniform_int_distribution<index_t> pick_row(0, m - 1);
+    std::uniform_int_distribution<index_t> pick_col(0, n - 1);
+    std::vector<value_t>                   values(n);
+
+    const index_t rows = std::max<index_t>(1, index_t(rate * m));
+    const index_t cols = std::max<index_t>(1, index_t(rate * n));
+
+    for (index_t i = 0; i < rows; i++) {
+        for (auto &value : values)
+            value = rng() % 8;
+        engine.set_row(pick_row(rng), values.data());
+    }
+
+    for (index_t i = 0; i < cols; i++)
+        engine.set_x(pick_col(rng), rng() % 8);
+}
+
+TEST_CASE("e_09_incremental_mult_check")
+{
+    spdlog::info("--- --- --- e_09_incremental_mult_check --- --- ---");
+
+    const uint64_t n = 300;
+    const uint64_t m = 200;
+
+    std::vector<uint64_t> A(m * n);
+    std::vector<uint64_t> x(n);
+    std::vector<uint64_t> expect(m);
+    init(A, x, m, n);
+
+    incremental_mult_t<uint64_t, uint64_t> engine(A, x, m, n);
+    std::mt19937                           rng(42);
+
+    // small edits take the incremental path, the last ones the full pass
+    for (double rate : {0.001, 0.005, 0.01, 0.5}) {
+        random_edits(engine, m, n, rate, rng);
+
+        const bool full = engine.apply();
+        CHECK(full == (rate >= 0.5));
+
+        sequential_mult(A, x, expect, m, n);
+        CHECK(engine.b() == expect);
+    }
+
+    // x only
+    engine.set_x(7, 1000);
+    engine.apply();
+    sequential_mult(A, x, expect, m, n);
+    CHECK(engine.b() == expect);
+}
+
+TEST_CASE("e_09_incremental_mult")
+{
+    spdlog::info("--- --- --- e_09_incremental_mult --- --- ---");
+
+    const uint64_t n = (1UL << 14);
+    const uint64_t m = (1UL << 14);
+
+    std::vector<uint64_t> A(m * n);
+    std::vector<uint64_t> x(n);
+    std::vector<uint64_t> b(m);
+    init(A, x, m, n);
+
+    incremental_mult_t<uint64_t, uint64_t> engine(A, x, m, n);
+    std::mt19937                           rng(42);
+
+    TIMERSTART(full_recompute);
+    block_parallel_mult(A, x, b, m, n);
+    TIMERSTOP(full_recompute);
+
+    for (double rate : {0.0001, 0.001, 0.01, 0.1}) {
+        random_edits(engine, m, n, rate, rng);
+
+        const auto                          start = std::chrono::steady_clock::now();
+        const bool                          full  = engine.apply();
+        const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+
+        spdlog::info("change rate {:>7.2f}%: {:.6f}s ({})", rate * 100, delta.count(), full ? "full" : "incremental");
+    }
+}
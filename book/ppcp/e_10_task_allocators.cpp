@@ -0,0 +1,256 @@
+/*********************************************************************
+ * \file   e_10_task_allocators.cpp
+ * \brief  arena and pool resources under promise / future task churn
+ *         heap allocations and tasks/s with std::allocator vs pmr
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <stdafx.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "hpc_helpers.hpp"
+#include "task_allocators.hpp"
+
+// upstream that counts what reaches it, blocks may come back on any thread
+class counting_resource_t : public std::pmr::memory_resource {
+public:
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+    {
+        deallocations.fetch_add(1, std::memory_order_relaxed);
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
+
+TEST_CASE("e_10_task_allocators_check")
+{
+    spdlog::info("--- --- --- e_10_task_allocators_check --- --- ---");
+
+    counting_resource_t upstream;
+
+    {
+        arena_resource_t arena(1024, &upstream);
+
+        // alignment, growth past the first chunk and an oversized request
+        for (size_t alignment : {1, 8, 16, 64}) {
+            void *ptr = arena.allocate(3, alignment);
+            CHECK(reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0);
+        }
+        for (int i = 0; i != 100; i++)
+            (void)arena.allocate(100);
+        (void)arena.allocate(100000);
+
+        const uint64_t chunks = upstream.allocations;
+        CHECK(chunks > 1);
+
+        // a rewound round of the same shape reuses the chunks
+        arena.reset();
+        for (int i = 0; i != 100; i++)
+            (void)arena.allocate(100);
+        (void)arena.allocate(100000);
+        CHECK(upstream.allocations == chunks);
+
+        // a scope hands back exactly what was allocated inside it
+        void *outer = arena.allocate(8, 8);
+        {
+            arena_scope_t scope(arena);
+            (void)arena.allocate(500);
+        }
+        CHECK(static_cast<char *>(arena.allocate(8, 8)) == static_cast<char *>(outer) + 8);
+    }
+    CHECK(upstream.deallocations == upstream.allocations);
+
+    {
+        pool_resource_t pool(TASK_STATE_SIZE, 64, &upstream);
+        const uint64_t  before = upstream.allocations;
+
+        std::vector<void *> blocks;
+        for (int i = 0; i != 64; i++)
+            blocks.push_back(pool.allocate(TASK_STATE_SIZE));
+        CHECK(upstream.allocations == before + 1);
+
+        // freed on another thread, handed back through the remote list
+        std::thread([&] {
+            for (auto block : blocks)
+                pool.deallocate(block, TASK_STATE_SIZE);
+        }).join();
+
+        for (int i = 0; i != 64; i++)
+            blocks[i] = pool.allocate(TASK_STATE_SIZE);
+        CHECK(upstream.allocations == before + 1);
+
+        for (auto block : blocks)
+            pool.deallocate(block, TASK_STATE_SIZE);
+
+        // larger than a block
+        void *large = pool.allocate(4 * TASK_STATE_SIZE);
+        CHECK(upstream.allocations == before + 2);
+        pool.deallocate(large, 4 * TASK_STATE_SIZE);
+    }
+    CHECK(upstream.deallocations == upstream.allocations);
+
+    // promise states on the pool, futures on the arena
+    {
+        arena_scope_t   scope;
+        pool_resource_t pool(TASK_STATE_SIZE);
+
+        std::pmr::vector<std::future<int>> futures(scope.resource());
+        std::pmr::vector<std::thread>      threads(scope.resource());
+
+        for (int i = 0; i != 8; i++) {
+            std::promise<int> promise(std::allocator_arg, std::pmr::polymorphic_allocator<int>(&pool));
+            futures.emplace_back(promise.get_future());
+            threads.emplace_back([i](std::promise<int> &&result) { result.set_value(i * i); }, std::move(promise));
+        }
+
+        for (int i = 0; i != 8; i++)
+            CHECK(futures[i].get() == i * i);
+        for (auto &thread : threads)
+            thread.join();
+    }
+}
+
+//
+// e_02 in batches: the main thread creates the tasks, every worker moves its share out and
+// fulfils it. the promise wrapper keeps pmr vectors from handing their own resource to the promise
+//
+
+struct task_t {
+    std::promise<uint64_t> result;
+    int                    n;
+};
+
+template <typename tasks_t>
+void fulfil(tasks_t &tasks, size_t id, size_t num_threads)
+{
+    for (size_t i = id; i < tasks.size(); i += num_threads) {
+        std::promise<uint64_t> result = std::move(tasks[i].result);
+
+        uint64_t a = 0, b = 1;
+        for (int k = 0; k != tasks[i].n; ++k) {
+            const uint64_t tmp = a;
+            a                  = b;
+            b += tmp;
+        }
+
+        result.set_value(a);
+    }
+}
+
+// what std::allocator does, through a counting heap: every vector grows one emplace_back at a
+// time, and every promise takes two heap blocks, its state and its result
+uint64_t std_round(counting_resource_t &heap, size_t num_tasks, size_t num_threads)
+{
+    std::pmr::vector<task_t>                tasks(&heap);
+    std::pmr::vector<std::future<uint64_t>> futures(&heap);
+    std::pmr::vector<std::thread>           threads(&heap);
+
+    const std::pmr::polymorphic_allocator<uint64_t> state(&heap);
+
+    for (size_t i = 0; i != num_tasks; i++) {
+        tasks.push_back(task_t{std::promise<uint64_t>(std::allocator_arg, state), int(i % 64)});
+        futures.emplace_back(tasks.back().result.get_future());
+    }
+
+    for (size_t id = 0; id != num_threads; id++)
+        threads.emplace_back(fulfil<std::pmr::vector<task_t>>, std::ref(tasks), id, num_threads);
+
+    uint64_t sum = 0;
+    for (auto &future : futures)
+        sum += future.get();
+
+    for (auto &thread : threads)
+        thread.join();
+
+    return sum;
+}
+
+// the same round, bookkeeping on the arena and promise states in the pool
+uint64_t pmr_round(arena_resource_t &arena, pool_resource_t &pool, size_t num_tasks, size_t num_threads)
+{
+    arena_scope_t scope(arena);
+
+    std::pmr::vector<task_t>                tasks(scope.resource());
+    std::pmr::vector<std::future<uint64_t>> futures(scope.resource());
+    std::pmr::vector<std::thread>           threads(scope.resource());
+
+    const std::pmr::polymorphic_allocator<uint64_t> state(&pool);
+
+    for (size_t i = 0; i != num_tasks; i++) {
+        tasks.push_back(task_t{std::promise<uint64_t>(std::allocator_arg, state), int(i % 64)});
+        futures.emplace_back(tasks.back().result.get_future());
+    }
+
+    for (size_t id = 0; id != num_threads; id++)
+        threads.emplace_back(fulfil<std::pmr::vector<task_t>>, std::ref(tasks), id, num_threads);
+
+    uint64_t sum = 0;
+    for (auto &future : futures)
+        sum += future.get();
+
+    for (auto &thread : threads)
+        thread.join();
+
+    return sum;
+}
+
+TEST_CASE("e_10_task_allocators")
+{
+    spdlog::info("--- --- --- e_10_task_allocators --- --- ---");
+
+    const size_t num_tasks  = 1UL << 14;
+    const size_t num_rounds = 64;
+
+    // only what the rounds allocate is counted, not the threads or the logger
+    counting_resource_t heap;
+    arena_resource_t    arena(64 * 1024, &heap);
+    pool_resource_t     pool(TASK_STATE_SIZE, 256, &heap);
+
+    // one untimed round each: the pool and the arena reach their steady state
+    const uint64_t expect = std_round(heap, num_tasks, 1);
+    CHECK(pmr_round(arena, pool, num_tasks, 1) == expect);
+
+    for (size_t num_threads : {1, 4}) {
+        auto measure = [&](const char *label, auto &&round) {
+            const uint64_t allocations = heap.allocations.load();
+            const auto     start       = std::chrono::steady_clock::now();
+
+            bool same = true;
+            for (size_t r = 0; r != num_rounds; r++)
+                same &= round() == expect;
+
+            const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+            const double per_round = double(heap.allocations.load() - allocations) / num_rounds;
+
+            CHECK(same);
+            spdlog::info("{:>4} {} threads: {:8.3f} M tasks/s, {:9.1f} heap allocations per {} tasks", label,
+                         num_threads, num_tasks * num_rounds / delta.count() / 1e6, per_round, num_tasks);
+            return per_round;
+        };
+
+        const double std_allocations = measure("std", [&] { return std_round(heap, num_tasks, num_threads); });
+        const double pmr_allocations = measure("pmr", [&] { return pmr_round(arena, pool, num_tasks, num_threads); });
+
+        CHECK(pmr_allocations == 0);
+        CHECK(std_allocations > 2 * num_tasks);
+    }
+}
@@ -0,0 +1,130 @@
+/*********************************************************************
+ * \file   e_11_fixed_mult.cpp
+ * \brief  size-specialized matvec kernels behind a runtime dispatch
+ *         batched small-matrix latency against the generic loop
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <stdafx.h>
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "hpc_helpers.hpp"
+#include "matvec.hpp"
+#include "matvec_fixed.hpp"
+
+template <typename value_t>
+void init_batch(std::vector<value_t> &values, uint32_t seed)
+{
+    std::mt19937 engine(seed);
+    for (auto &value : values)
+        value = value_t(engine() % 16);
+}
+
+template <typename value_t>
+bool same_result(const std::vector<value_t> &b, const std::vector<value_t> &expect)
+{
+    // small integers: exact for integers, floats only differ in the summation order
+    for (size_t row = 0; row < b.size(); row++)
+        if (std::fabs(double(b[row]) - double(expect[row])) > 1e-6 * std::fabs(double(expect[row])))
+            return false;
+    return true;
+}
+
+template <typename value_t>
+void check_shapes()
+{
+    // tile multiples, row tails, and one shape that takes the generic path
+    for (uint64_t n : {64, 128, 256, 1024, 100}) {
+        for (uint64_t m : {1, 7, 37, 64}) {
+            std::vector<value_t> A(m * n), x(n), b(m), expect(m);
+            init_batch(A, 1);
+            init_batch(x, 2);
+
+            sequential_mult(A, x, expect, m, n);
+
+            dispatch_sequential_mult(A, x, b, m, n);
+            CHECK(same_result(b, expect));
+
+            std::fill(b.begin(), b.end(), value_t(0));
+            dispatch_block_parallel_mult(A, x, b, m, n, uint64_t(3));
+            CHECK(same_result(b, expect));
+        }
+    }
+
+    CHECK(select_rows_kernel<value_t, uint64_t>(100) == generic_rows_mult<value_t, uint64_t>);
+    CHECK(select_rows_kernel<value_t, uint64_t>(256) == fixed_rows_mult<value_t, uint64_t, 256>);
+}
+
+TEST_CASE("e_11_fixed_mult_check")
+{
+    spdlog::info("--- --- --- e_11_fixed_mult_check --- --- ---");
+
+    check_shapes<uint64_t>();
+    check_shapes<uint32_t>();
+    check_shapes<float>();
+    check_shapes<double>();
+}
+
+template <typename value_t>
+void compare_batched(const char *type)
+{
+    // 16M values per shape: n x n matrices, as many as fit
+    for (uint64_t n : {64, 128, 256, 1024}) {
+        const uint64_t batch = (1UL << 24) / (n * n);
+
+        std::vector<value_t> A(batch * n * n), x(batch * n), b(batch * n), expect(batch * n);
+        init_batch(A, 3);
+        init_batch(x, 4);
+
+        auto measure = [&](rows_kernel_t<value_t, uint64_t> kernel, std::vector<value_t> &result) {
+            batched_mult(kernel, A, x, result, batch, n, n);
+
+            const auto start = std::chrono::steady_clock::now();
+            for (int rep = 0; rep != 4; rep++)
+                batched_mult(kernel, A, x, result, batch, n, n);
+            const std::chrono::duration<double> delta = std::chrono::steady_clock::now() - start;
+
+            return delta.count() / (4 * batch) * 1e9;
+        };
+
+        const double generic = measure(generic_rows_mult<value_t, uint64_t>, expect);
+        const double fixed   = measure(select_rows_kernel<value_t, uint64_t>(n), b);
+
+        CHECK(same_result(b, expect));
+        spdlog::info("{:>6} n {:>4} x {:>5}: generic {:10.1f} ns, fixed {:10.1f} ns per matvec, {:5.2f}x", type, n,
+                     batch, generic, fixed, generic / fixed);
+    }
+}
+
+TEST_CASE("e_11_fixed_mult")
+{
+    spdlog::info("--- --- --- e_11_fixed_mult --- --- ---");
+
+    compare_batched<float>("float");
+    compare_batched<double>("double");
+    compare_batched<uint32_t>("uint32");
+    compare_batched<uint64_t>("uint64");
+
+    // one large matrix with a specialized row length
+    const uint64_t n = 1024;
+    const uint64_t m = (1UL << 15);
+
+    std::vector<double> A(m * n);
+    std::vector<double> x(n);
+    std::vector<double> b(m);
+    init(A, x, m, n);
+
+    TIMERSTART(block_parallel_mult);
+    block_parallel_mult(A, x, b, m, n);
+    TIMERSTOP(block_parallel_mult);
+
+    TIMERSTART(dispatch_block_parallel_mult);
+    dispatch_block_parallel_mult(A, x, b, m, n);
+    TIMERSTOP(dispatch_block_parallel_mult);
+}
@@ -0,0 +1,77 @@
+/*********************************************************************
+ * \file   false_sharing.hpp
+ * \brief  independent counters on shared and on private cache lines
+ *         the e_04 pair and its generalization to num_threads counters.
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+struct pack_t {
+    uint64_t ying;
+    uint64_t yang;
+
+    pack_t()
+        : ying(0)
+        , yang(0)
+    {
+    }
+};
+
+inline void sequential_increment(volatile pack_t &pack, uint64_t iterations = 1UL << 30)
+{
+
+    for (uint64_t index = 0; index < iterations; index++) {
+        pack.ying++;
+        pack.yang++;
+    }
+}
+
+inline void false_sharing_increment(volatile pack_t &pack, uint64_t iterations = 1UL << 30)
+{
+
+    auto eval_ying = [&pack, iterations]() -> void {
+        for (uint64_t index = 0; index < iterations; index++)
+            pack.ying++;
+    };
+
+    auto eval_yang = [&pack, iterations]() -> void {
+        for (uint64_t index = 0; index < iterations; index++)
+            pack.yang++;
+    };
+
+    std::thread ying_thread(eval_ying);
+    std::thread yang_thread(eval_yang);
+    ying_thread.join();
+    yang_thread.join();
+}
+
+// thread id increments counters[id * stride]: stride 1 packs all counters into
+// shared lines, a stride of one cache line gives every thread its own line
+inline void strided_increment(std::vector<uint64_t> &counters,
+                              uint64_t               num_threads,
+                              uint64_t               stride,
+                              uint64_t               iterations = 1UL << 30)
+{
+    counters.assign(num_threads * stride, 0);
+
+    auto eval = [&](const uint64_t &id) -> void {
+        volatile uint64_t &counter = counters[id * stride];
+        for (uint64_t index = 0; index < iterations; index++)
+            counter++;
+    };
+
+    std::vector<std::thread> threads;
+
+    for (uint64_t id = 0; id < num_threads; id++)
+        threads.emplace_back(eval, id);
+
+    for (auto &thread : threads)
+        thread.join();
+}
@@ -0,0 +1,120 @@
+/*********************************************************************
+ * \file   fibonacci.hpp
+ * \brief  fibonacci kernels of e_02 and e_05
+ *         the promise loop fanned out on threads, the big-number
+ *         iterative loop and fast doubling with forked products.
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <memory_resource>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "big_uint.hpp"
+#include "task_allocators.hpp"
+
+template <typename value_t>
+void fibonacci(int n, std::promise<value_t> &&result)
+{
+    value_t a = 0;
+    value_t b = 1;
+
+    for (int i = 0; i != n; ++i) {
+
+        const value_t tmp = a;
+
+        a = b;
+        b += tmp;
+    }
+
+    result.set_value(a);
+}
+
+// one thread per result, each one computes F(n) on its own promise.
+// bookkeeping lives on the thread arena, promise states in a pool
+template <typename value_t>
+std::vector<value_t> fibonacci_fan_out(int n, int num_threads)
+{
+    arena_scope_t   scope;
+    pool_resource_t pool(TASK_STATE_SIZE);
+
+    std::pmr::vector<std::thread>          threads(scope.resource());
+    std::pmr::vector<std::future<value_t>> futures(scope.resource());
+
+    for (int i = 0; i != num_threads; ++i) {
+
+        std::promise<value_t> promise(std::allocator_arg, std::pmr::polymorphic_allocator<value_t>(&pool));
+        futures.emplace_back(promise.get_future());
+
+        threads.emplace_back(fibonacci<value_t>, n, std::move(promise));
+    }
+
+    std::vector<value_t> results;
+    for (auto &&future : futures)
+        results.push_back(future.get());
+
+    for (auto &&t : threads)
+        t.join();
+
+    return results;
+}
+
+// the e_02 loop on big numbers: n additions of growing operands, O(n^2)
+inline big_uint_t iterative_fibonacci(uint64_t n)
+{
+    big_uint_t a = 0;
+    big_uint_t b = 1;
+
+    for (uint64_t i = 0; i != n; ++i) {
+        a += b;
+        std::swap(a, b);
+    }
+
+    return a;
+}
+
+// limbs of F(n), n log2(phi) bits: sizes the parallel depth of the products
+inline size_t fibonacci_limbs(uint64_t n)
+{
+    return size_t(double(n) * 0.6942419136306174 / 32) + 1;
+}
+
+// O(log n) multiplications, each one forks its sub-products up to depth levels.
+// the largest ones, in the last step, multiply numbers of fibonacci_limbs(n / 2)
+inline big_uint_t fast_fibonacci(uint64_t n, unsigned depth)
+{
+    big_uint_t a = 0; // F(k)
+    big_uint_t b = 1; // F(k+1)
+
+    // leading zero bits would only double F(0)
+    int top = 63;
+    while (top >= 0 && ((n >> top) & 1) == 0)
+        --top;
+
+    for (int bit = top; bit >= 0; --bit) {
+
+        big_uint_t twice_b = b;
+        twice_b <<= 1;
+
+        const big_uint_t c = big_uint_t::mult(a, twice_b - a, depth);
+        const big_uint_t d = big_uint_t::mult(a, a, depth) + big_uint_t::mult(b, b, depth);
+
+        if ((n >> bit) & 1) {
+            a = d;
+            b = c + d;
+        }
+        else {
+            a = c;
+            b = d;
+        }
+    }
+
+    return a;
+}
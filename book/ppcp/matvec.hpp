@@ -0,0 +1,293 @@
+/*********************************************************************
+ * \file   matvec.hpp
+ * \brief  dense matrix vector multiplication b = A*x kernels
+ *         A is m x n, row-major.
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "hpc_helpers.hpp"
+
+template <typename value_t, typename index_t>
+void init(std::vector<value_t> &A, std::vector<value_t> &x, index_t m, index_t n)
+{
+    for (index_t row = 0; row != m; ++row) {
+        for (index_t col = 0; col != n; ++col) {
+            A[row * n + col] = row > col ? 1 : 0;
+        }
+    }
+
+    for (index_t col = 0; col < n; ++col) {
+        x[col] = col;
+    }
+}
+
+template <typename value_t, typename index_t>
+void sequential_mult(std::vector<value_t> &A,
+                     std::vector<value_t> &x,
+                     std::vector<value_t> &b,
+                     index_t               m,
+                     index_t               n)
+{
+
+    for (index_t row = 0; row < m; row++) {
+        value_t accum = value_t(0);
+        for (index_t col = 0; col < n; col++)
+            accum += A[row * n + col] * x[col];
+        b[row] = accum;
+    }
+}
+
+template <typename value_t, typename index_t>
+void block_parallel_mult(std::vector<value_t> &A,
+                         std::vector<value_t> &x,
+                         std::vector<value_t> &b,
+                         index_t               m,
+                         index_t               n,
+                         index_t               num_threads = 8)
+{
+    auto block = [&](const index_t &id) -> void {
+        const index_t chunk = SDIV(m, num_threads);
+        const index_t lower = id * chunk;
+        const index_t upper = std::min(lower + chunk, m);
+
+        for (index_t row = lower; row < upper; row++) {
+            value_t accum = value_t(0);
+            for (index_t col = 0; col < n; col++)
+                accum += A[row * n + col] * x[col];
+            b[row] = accum;
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (index_t id = 0; id < num_threads; id++)
+        threads.emplace_back(block, id);
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+template <typename value_t, typename index_t>
+void cyclic_parallel_mult(std::vector<value_t> &A,
+                          std::vector<value_t> &x,
+                          std::vector<value_t> &b,
+                          index_t               m,
+                          index_t               n,
+                          index_t               num_threads = 8)
+{
+    auto cyclic = [&](const index_t &id) -> void {
+        for (index_t row = id; row < m; row += num_threads) {
+            value_t accum = value_t(0);
+            for (index_t col = 0; col < n; col++) {
+                // false sharing!!
+                // b[row] += A[row * n + col] * x[col];
+
+                accum += A[row * n + col] * x[col];
+            }
+            b[row] = accum;
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (index_t id = 0; id < num_threads; id++)
+        threads.emplace_back(cyclic, id);
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+// rows are handed out chunk by chunk from a shared counter, threads that
+// finish early take more: uneven rows or cores are balanced at run time
+template <typename value_t, typename index_t>
+void dynamic_parallel_mult(std::vector<value_t> &A,
+                           std::vector<value_t> &x,
+                           std::vector<value_t> &b,
+                           index_t               m,
+                           index_t               n,
+                           index_t               num_threads = 8,
+                           index_t               chunk_size  = 16)
+{
+    std::atomic<index_t> next_row(0);
+
+    auto dynamic = [&](const index_t &) -> void {
+        for (index_t lower = next_row.fetch_add(chunk_size); lower < m; lower = next_row.fetch_add(chunk_size)) {
+            const index_t upper = std::min(lower + chunk_size, m);
+
+            for (index_t row = lower; row < upper; row++) {
+                value_t accum = value_t(0);
+                for (index_t col = 0; col < n; col++)
+                    accum += A[row * n + col] * x[col];
+                b[row] = accum;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (index_t id = 0; id < num_threads; id++)
+        threads.emplace_back(dynamic, id);
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+template <typename value_t>
+value_t *align_to_cache_line(value_t *ptr)
+{
+    const auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+    return reinterpret_cast<value_t *>(SDIV(addr, CACHE_LINE_SIZE) * CACHE_LINE_SIZE);
+}
+
+//
+// transposed b = A^T * x on the same row-major storage, A is m x n, x has m, b has n entries
+//
+
+template <typename value_t, typename index_t>
+void sequential_transposed_mult(std::vector<value_t> &A,
+                                std::vector<value_t> &x,
+                                std::vector<value_t> &b,
+                                index_t               m,
+                                index_t               n)
+{
+    std::fill(b.begin(), b.begin() + n, value_t(0));
+
+    for (index_t row = 0; row < m; row++) {
+        const value_t x_row = x[row];
+        for (index_t col = 0; col < n; col++)
+            b[col] += A[row * n + col] * x_row;
+    }
+}
+
+template <typename value_t>
+void atomic_add(std::atomic<value_t> &target, value_t value)
+{
+    if constexpr (std::is_integral_v<value_t>) {
+        target.fetch_add(value, std::memory_order_relaxed);
+    }
+    else {
+        value_t expected = target.load(std::memory_order_relaxed);
+        while (!target.compare_exchange_weak(expected, expected + value, std::memory_order_relaxed))
+            ;
+    }
+}
+
+// every thread scatters its row block straight into the shared result,
+// all threads hit the same columns: contention on every single add
+template <typename value_t, typename index_t>
+void atomic_transposed_mult(std::vector<value_t> &A,
+                            std::vector<value_t> &x,
+                            std::vector<value_t> &b,
+                            index_t               m,
+                            index_t               n,
+                            index_t               num_threads = 8)
+{
+    std::vector<std::atomic<value_t>> accum(n);
+
+    for (auto &entry : accum)
+        entry.store(value_t(0), std::memory_order_relaxed);
+
+    auto block = [&](const index_t &id) -> void {
+        const index_t chunk = SDIV(m, num_threads);
+        const index_t lower = id * chunk;
+        const index_t upper = std::min(lower + chunk, m);
+
+        for (index_t row = lower; row < upper; row++) {
+            const value_t x_row = x[row];
+            for (index_t col = 0; col < n; col++)
+                atomic_add(accum[col], A[row * n + col] * x_row);
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (index_t id = 0; id < num_threads; id++)
+        threads.emplace_back(block, id);
+
+    for (auto &thread : threads)
+        thread.join();
+
+    for (index_t col = 0; col < n; col++)
+        b[col] = accum[col].load(std::memory_order_relaxed);
+}
+
+// every thread accumulates its row block into a private partial vector,
+// the partials are then summed column-blockwise: no atomics, no shared lines
+template <typename value_t, typename index_t>
+void private_transposed_mult(std::vector<value_t> &A,
+                             std::vector<value_t> &x,
+                             std::vector<value_t> &b,
+                             index_t               m,
+                             index_t               n,
+                             index_t               num_threads = 8)
+{
+    // pad every partial to whole cache lines, no two partials share a line
+    const index_t line   = std::max<index_t>(1, CACHE_LINE_SIZE / sizeof(value_t));
+    const index_t stride = SDIV(n, line) * line;
+
+    // left uninitialized, the owning thread touches its partial first
+    std::unique_ptr<value_t[]> storage(new value_t[num_threads * stride + line]);
+    value_t                   *partials = align_to_cache_line(storage.get());
+
+    auto accumulate = [&](const index_t &id) -> void {
+        const index_t chunk   = SDIV(m, num_threads);
+        const index_t lower   = id * chunk;
+        const index_t upper   = std::min(lower + chunk, m);
+        value_t      *partial = partials + id * stride;
+
+        // first touch by the owning thread
+        std::fill(partial, partial + n, value_t(0));
+
+        for (index_t row = lower; row < upper; row++) {
+            const value_t x_row = x[row];
+            for (index_t col = 0; col < n; col++)
+                partial[col] += A[row * n + col] * x_row;
+        }
+    };
+
+    // b itself is not aligned: column blocks start at its line boundaries, so the writes to b do not collide
+    const index_t head  = index_t(CACHE_LINE_SIZE - reinterpret_cast<uintptr_t>(b.data()) % CACHE_LINE_SIZE) %
+                          CACHE_LINE_SIZE / sizeof(value_t);
+    const index_t chunk = SDIV(SDIV(n, num_threads), line) * line;
+
+    auto edge = [&](index_t id) -> index_t { return id == 0 ? 0 : std::min(head + id * chunk, n); };
+
+    auto reduce = [&](const index_t &id) -> void {
+        const index_t lower = edge(id);
+        const index_t upper = edge(id + 1);
+
+        for (index_t col = lower; col < upper; col++) {
+            value_t accum = value_t(0);
+            for (index_t part = 0; part < num_threads; part++)
+                accum += partials[part * stride + col];
+            b[col] = accum;
+        }
+    };
+
+    auto run = [&](auto &&phase) -> void {
+        std::vector<std::thread> threads;
+
+        for (index_t id = 0; id < num_threads; id++)
+            threads.emplace_back(phase, id);
+
+        for (auto &thread : threads)
+            thread.join();
+    };
+
+    run(accumulate);
+    run(reduce);
+}
@@ -0,0 +1,172 @@
+/*********************************************************************
+ * \file   matvec_fixed.hpp
+ * \brief  b = A*x specialized on a compile-time column count
+ *         lanes, row tile and unroll are constexpr per shape, a runtime
+ *         table routes n = 64, 128, 256, 1024 to them, others generic.
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "hpc_helpers.hpp"
+
+// one avx2 register
+constexpr size_t VECTOR_BYTES = 32;
+
+template <typename value_t, size_t columns>
+struct fixed_tile_t {
+    // values per vector, narrowed until they divide the row: no column tail
+    static constexpr size_t LANES = std::gcd(std::max<size_t>(1, VECTOR_BYTES / sizeof(value_t)), columns);
+
+    // short rows: more rows share one pass over x
+    static constexpr size_t ROWS = columns * sizeof(value_t) <= 1024 ? 8 : 4;
+
+    // ROWS * UNROLL independent vector sums hide the add latency
+    static constexpr size_t UNROLL = std::gcd(columns / LANES, std::max<size_t>(1, 8 / ROWS));
+
+    static constexpr size_t STEP = LANES * UNROLL;
+};
+
+// rows [lower, upper) of the plain loop, the reference for every shape
+template <typename value_t, typename index_t>
+void generic_rows_mult(const value_t *A, const value_t *x, value_t *b, index_t lower, index_t upper, index_t n)
+{
+    for (index_t row = lower; row < upper; row++) {
+        value_t accum = value_t(0);
+        for (index_t col = 0; col < n; col++)
+            accum += A[row * n + col] * x[col];
+        b[row] = accum;
+    }
+}
+
+// rows [lower, upper) with n == columns, ROWS x STEP partial sums per tile.
+// floating point sums come out in a different order than the generic loop
+template <typename value_t, typename index_t, index_t columns>
+void fixed_rows_mult(const value_t *A, const value_t *x, value_t *b, index_t lower, index_t upper, index_t)
+{
+    static_assert(std::is_arithmetic_v<value_t>, "fixed kernels need a native value type");
+
+    using tile = fixed_tile_t<value_t, columns>;
+
+    index_t row = lower;
+    for (; row + index_t(tile::ROWS) <= upper; row += tile::ROWS) {
+        value_t accum[tile::ROWS][tile::STEP] = {};
+
+        for (index_t col = 0; col < columns; col += tile::STEP)
+            for (size_t r = 0; r < tile::ROWS; r++)
+                for (size_t lane = 0; lane < tile::STEP; lane++)
+                    accum[r][lane] += A[(row + r) * columns + col + lane] * x[col + lane];
+
+        for (size_t r = 0; r < tile::ROWS; r++) {
+            value_t sum = value_t(0);
+            for (size_t lane = 0; lane < tile::STEP; lane++)
+                sum += accum[r][lane];
+            b[row + r] = sum;
+        }
+    }
+
+    // rows left over by the tile
+    for (; row < upper; row++) {
+        value_t accum[tile::STEP] = {};
+
+        for (index_t col = 0; col < columns; col += tile::STEP)
+            for (size_t lane = 0; lane < tile::STEP; lane++)
+                accum[lane] += A[row * columns + col + lane] * x[col + lane];
+
+        value_t sum = value_t(0);
+        for (size_t lane = 0; lane < tile::STEP; lane++)
+            sum += accum[lane];
+        b[row] = sum;
+    }
+}
+
+//
+// runtime dispatch: one table entry per specialized column count
+//
+
+template <typename value_t, typename index_t>
+using rows_kernel_t = void (*)(const value_t *, const value_t *, value_t *, index_t, index_t, index_t);
+
+template <typename value_t, typename index_t, index_t... columns>
+rows_kernel_t<value_t, index_t> select_rows_kernel_of(index_t n)
+{
+    struct entry_t {
+        index_t                         n;
+        rows_kernel_t<value_t, index_t> kernel;
+    };
+
+    static constexpr entry_t table[] = {{columns, fixed_rows_mult<value_t, index_t, columns>}...};
+
+    for (const auto &entry : table)
+        if (entry.n == n)
+            return entry.kernel;
+
+    return generic_rows_mult<value_t, index_t>;
+}
+
+// the shapes we run
+template <typename value_t, typename index_t>
+rows_kernel_t<value_t, index_t> select_rows_kernel(index_t n)
+{
+    return select_rows_kernel_of<value_t, index_t, 64, 128, 256, 1024>(n);
+}
+
+template <typename value_t, typename index_t>
+void dispatch_sequential_mult(std::vector<value_t> &A,
+                              std::vector<value_t> &x,
+                              std::vector<value_t> &b,
+                              index_t               m,
+                              index_t               n)
+{
+    select_rows_kernel<value_t, index_t>(n)(A.data(), x.data(), b.data(), index_t(0), m, n);
+}
+
+template <typename value_t, typename index_t>
+void dispatch_block_parallel_mult(std::vector<value_t> &A,
+                                  std::vector<value_t> &x,
+                                  std::vector<value_t> &b,
+                                  index_t               m,
+                                  index_t               n,
+                                  index_t               num_threads = 8)
+{
+    const auto kernel = select_rows_kernel<value_t, index_t>(n);
+
+    auto block = [&](const index_t &id) -> void {
+        const index_t chunk = SDIV(m, num_threads);
+        const index_t lower = std::min(id * chunk, m);
+        const index_t upper = std::min(lower + chunk, m);
+
+        kernel(A.data(), x.data(), b.data(), lower, upper, n);
+    };
+
+    std::vector<std::thread> threads;
+
+    for (index_t id = 0; id < num_threads; id++)
+        threads.emplace_back(block, id);
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+// many small b_i = A_i * x_i, the A_i (m x n), x_i and b_i stored back to back
+template <typename value_t, typename index_t>
+void batched_mult(rows_kernel_t<value_t, index_t> kernel,
+                  std::vector<value_t>           &A,
+                  std::vector<value_t>           &x,
+                  std::vector<value_t>           &b,
+                  index_t                         batch,
+                  index_t                         m,
+                  index_t                         n)
+{
+    for (index_t i = 0; i < batch; i++)
+        kernel(A.data() + i * m * n, x.data() + i * n, b.data() + i * m, index_t(0), m, n);
+}
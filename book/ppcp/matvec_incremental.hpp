@@ -0,0 +1,190 @@
+/*********************************************************************
+ * \file   matvec_incremental.hpp
+ * \brief  keeps b = A*x up to date under small edits of A and x
+ *         dirty rows are recomputed, an x delta is applied as
+ *         b += A[:, j] * dx_j, large edits fall back to a full pass.
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "hpc_helpers.hpp"
+#include "matvec.hpp"
+
+template <typename value_t, typename index_t>
+class incremental_mult_t {
+public:
+    // a column gather touches a whole cache line for one value
+    static constexpr index_t GATHER_COST = CACHE_LINE_SIZE / sizeof(value_t);
+
+    // corrections below this many element updates are not worth a thread spawn
+    static constexpr index_t PARALLEL_WORK = index_t(1) << 20;
+
+    incremental_mult_t(std::vector<value_t> &A,
+                       std::vector<value_t> &x,
+                       index_t               m,
+                       index_t               n,
+                       index_t               num_threads = 8,
+                       double                threshold   = 0.25)
+        : A_(A)
+        , x_(x)
+        , m_(m)
+        , n_(n)
+        , num_threads_(num_threads)
+        , threshold_(threshold)
+        , applied_x_(x)
+        , b_(m)
+        , row_dirty_(m, false)
+        , col_dirty_(n, false)
+    {
+        recompute_all();
+    }
+
+    // edits go through the engine so they can be tracked
+    void set_entry(index_t row, index_t col, value_t value)
+    {
+        A_[row * n_ + col] = value;
+        mark_row(row);
+    }
+
+    void set_row(index_t row, const value_t *values)
+    {
+        std::copy(values, values + n_, A_.begin() + row * n_);
+        mark_row(row);
+    }
+
+    void set_x(index_t col, value_t value)
+    {
+        x_[col] = value;
+        if (!col_dirty_[col]) {
+            col_dirty_[col] = true;
+            dirty_cols_.push_back(col);
+        }
+    }
+
+    // estimated element updates of the incremental path, relative to m*n
+    double pending_cost() const
+    {
+        const double corrections = double(m_) * dirty_cols_.size() * GATHER_COST;
+        const double rows        = double(dirty_rows_.size()) * n_;
+        return (corrections + rows) / (double(m_) * n_);
+    }
+
+    // brings b up to date, returns true if the full recompute was taken
+    bool apply()
+    {
+        const bool full = pending_cost() > threshold_;
+
+        if (full) {
+            recompute_all();
+        }
+        else {
+            apply_x_delta();
+            recompute_dirty_rows();
+        }
+
+        for (auto col : dirty_cols_) {
+            applied_x_[col] = x_[col];
+            col_dirty_[col] = false;
+        }
+        for (auto row : dirty_rows_)
+            row_dirty_[row] = false;
+
+        dirty_cols_.clear();
+        dirty_rows_.clear();
+        return full;
+    }
+
+    const std::vector<value_t> &b() const { return b_; }
+
+private:
+    void mark_row(index_t row)
+    {
+        if (!row_dirty_[row]) {
+            row_dirty_[row] = true;
+            dirty_rows_.push_back(row);
+        }
+    }
+
+    template <typename func_t>
+    void for_row_blocks(index_t rows, bool parallel, func_t &&func)
+    {
+        if (!parallel) {
+            func(index_t(0), rows);
+            return;
+        }
+
+        std::vector<std::thread> threads;
+        const index_t            chunk = SDIV(rows, num_threads_);
+
+        for (index_t id = 0; id < num_threads_; id++)
+            threads.emplace_back(func, std::min(id * chunk, rows), std::min(id * chunk + chunk, rows));
+
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    void recompute_all()
+    {
+        block_parallel_mult(A_, x_, b_, m_, n_, num_threads_);
+    }
+
+    // rank-k correction, k = number of changed entries of x
+    void apply_x_delta()
+    {
+        if (dirty_cols_.empty())
+            return;
+
+        std::vector<value_t> delta(dirty_cols_.size());
+        for (size_t i = 0; i < dirty_cols_.size(); i++)
+            delta[i] = x_[dirty_cols_[i]] - applied_x_[dirty_cols_[i]];
+
+        const bool parallel = index_t(dirty_cols_.size()) * m_ >= PARALLEL_WORK;
+
+        for_row_blocks(m_, parallel, [&](index_t lower, index_t upper) {
+            for (index_t row = lower; row < upper; row++) {
+                value_t accum = value_t(0);
+                for (size_t i = 0; i < dirty_cols_.size(); i++)
+                    accum += A_[row * n_ + dirty_cols_[i]] * delta[i];
+                b_[row] += accum;
+            }
+        });
+    }
+
+    // dirty rows see the new x in full, this overrides their correction above
+    void recompute_dirty_rows()
+    {
+        const bool parallel = index_t(dirty_rows_.size()) * n_ >= PARALLEL_WORK;
+
+        for_row_blocks(index_t(dirty_rows_.size()), parallel, [&](index_t lower, index_t upper) {
+            for (index_t i = lower; i < upper; i++) {
+                const index_t row   = dirty_rows_[i];
+                value_t       accum = value_t(0);
+                for (index_t col = 0; col < n_; col++)
+                    accum += A_[row * n_ + col] * x_[col];
+                b_[row] = accum;
+            }
+        });
+    }
+
+    std::vector<value_t> &A_;
+    std::vector<value_t> &x_;
+    index_t               m_;
+    index_t               n_;
+    index_t               num_threads_;
+    double                threshold_;
+
+    std::vector<value_t> applied_x_;
+    std::vector<value_t> b_;
+
+    std::vector<bool>    row_dirty_;
+    std::vector<bool>    col_dirty_;
+    std::vector<index_t> dirty_rows_;
+    std::vector<index_t> dirty_cols_;
+};
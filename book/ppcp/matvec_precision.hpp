@@ -0,0 +1,190 @@
+/*********************************************************************
+ * \file   matvec_precision.hpp
+ * \brief  type-generic b = A*x with selectable accumulation
+ *         plain, wide (double), kahan and pairwise summation,
+ *         all but plain keep LANES independent sums to vectorize.
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "hpc_helpers.hpp"
+
+//
+// bfloat16 storage: upper half of an ieee float, arithmetic happens in float
+//
+
+struct bfloat16_t {
+    uint16_t bits;
+
+    bfloat16_t() = default;
+
+    bfloat16_t(float value)
+    {
+        uint32_t u;
+        std::memcpy(&u, &value, sizeof(u));
+
+        if ((u & 0x7fffffffu) > 0x7f800000u) {
+            // keep nan quiet
+            bits = uint16_t((u >> 16) | 0x40u);
+        }
+        else {
+            // round to nearest even
+            bits = uint16_t((u + 0x7fffu + ((u >> 16) & 1u)) >> 16);
+        }
+    }
+
+    operator float() const
+    {
+        const uint32_t u = uint32_t(bits) << 16;
+        float          value;
+        std::memcpy(&value, &u, sizeof(value));
+        return value;
+    }
+};
+
+// native arithmetic type of a storage type
+template <typename value_t>
+using compute_t = std::conditional_t<std::is_same_v<value_t, bfloat16_t>, float, value_t>;
+
+// independent partial sums per row, wide enough for avx2 floats
+constexpr size_t LANES = 8;
+
+//
+// accumulation policies: dot(a, x, n) over one row
+//
+
+// the e_03 loop, one dependent chain
+struct plain_accum {
+    template <typename value_t, typename index_t>
+    static compute_t<value_t> dot(const value_t *a, const value_t *x, index_t n)
+    {
+        compute_t<value_t> accum = 0;
+        for (index_t col = 0; col < n; col++)
+            accum += compute_t<value_t>(a[col]) * compute_t<value_t>(x[col]);
+        return accum;
+    }
+};
+
+// products in storage precision, sums in double
+struct wide_accum {
+    template <typename value_t, typename index_t>
+    static double dot(const value_t *a, const value_t *x, index_t n)
+    {
+        double        lanes[LANES] = {};
+        const index_t body         = n - n % LANES;
+
+        for (index_t col = 0; col < body; col += LANES)
+            for (size_t lane = 0; lane < LANES; lane++)
+                lanes[lane] += double(compute_t<value_t>(a[col + lane]) * compute_t<value_t>(x[col + lane]));
+
+        for (index_t col = body; col < n; col++)
+            lanes[0] += double(compute_t<value_t>(a[col]) * compute_t<value_t>(x[col]));
+
+        double accum = 0;
+        for (size_t lane = 0; lane < LANES; lane++)
+            accum += lanes[lane];
+        return accum;
+    }
+};
+
+// compensated summation in storage precision, one compensation per lane
+struct kahan_accum {
+    template <typename real_t>
+    static void add(real_t &sum, real_t &comp, real_t value)
+    {
+        const real_t y = value - comp;
+        const real_t t = sum + y;
+        comp           = (t - sum) - y;
+        sum            = t;
+    }
+
+    template <typename value_t, typename index_t>
+    static compute_t<value_t> dot(const value_t *a, const value_t *x, index_t n)
+    {
+        using real_t = compute_t<value_t>;
+
+        real_t        sums[LANES]  = {};
+        real_t        comps[LANES] = {};
+        const index_t body         = n - n % LANES;
+
+        for (index_t col = 0; col < body; col += LANES)
+            for (size_t lane = 0; lane < LANES; lane++)
+                add(sums[lane], comps[lane], real_t(a[col + lane]) * real_t(x[col + lane]));
+
+        for (index_t col = body; col < n; col++)
+            add(sums[0], comps[0], real_t(a[col]) * real_t(x[col]));
+
+        real_t sum = 0, comp = 0;
+        for (size_t lane = 0; lane < LANES; lane++)
+            add(sum, comp, sums[lane] - comps[lane]);
+        return sum - comp;
+    }
+};
+
+// lane sums over short blocks, blocks combined as a binary tree: O(log n) error growth
+struct pairwise_accum {
+    static constexpr size_t BLOCK = 16 * LANES;
+
+    template <typename value_t, typename index_t>
+    static compute_t<value_t> dot(const value_t *a, const value_t *x, index_t n)
+    {
+        using real_t = compute_t<value_t>;
+
+        if (n <= index_t(BLOCK)) {
+            real_t        lanes[LANES] = {};
+            const index_t body         = n - n % LANES;
+
+            for (index_t col = 0; col < body; col += LANES)
+                for (size_t lane = 0; lane < LANES; lane++)
+                    lanes[lane] += real_t(a[col + lane]) * real_t(x[col + lane]);
+
+            for (index_t col = body; col < n; col++)
+                lanes[0] += real_t(a[col]) * real_t(x[col]);
+
+            for (size_t width = LANES / 2; width != 0; width /= 2)
+                for (size_t lane = 0; lane < width; lane++)
+                    lanes[lane] += lanes[lane + width];
+            return lanes[0];
+        }
+
+        // split on a block boundary so the leaves stay full
+        const index_t half = SDIV(n / 2, index_t(BLOCK)) * index_t(BLOCK);
+        return dot(a, x, half) + dot(a + half, x + half, n - half);
+    }
+};
+
+template <typename accum_t, typename value_t, typename result_t, typename index_t>
+void precision_block_parallel_mult(std::vector<value_t>  &A,
+                                   std::vector<value_t>  &x,
+                                   std::vector<result_t> &b,
+                                   index_t                m,
+                                   index_t                n,
+                                   index_t                num_threads = 8)
+{
+    auto block = [&](const index_t &id) -> void {
+        const index_t chunk = SDIV(m, num_threads);
+        const index_t lower = id * chunk;
+        const index_t upper = std::min(lower + chunk, m);
+
+        for (index_t row = lower; row < upper; row++)
+            b[row] = result_t(accum_t::dot(A.data() + row * n, x.data(), n));
+    };
+
+    std::vector<std::thread> threads;
+
+    for (index_t id = 0; id < num_threads; id++)
+        threads.emplace_back(block, id);
+
+    for (auto &thread : threads)
+        thread.join();
+}
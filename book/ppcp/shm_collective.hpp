@@ -0,0 +1,260 @@
+/*********************************************************************
+ * \file   shm_collective.hpp
+ * \brief  forked worker processes over posix shared memory
+ *         barrier, broadcast and gather(v) shaped like their mpi
+ *         counterparts, so the communicator can be swapped later.
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "hpc_helpers.hpp"
+
+class shm_comm_t {
+public:
+    // staging_bytes bounds a single broadcast / gather payload
+    shm_comm_t(int size, size_t staging_bytes)
+        : size_(size)
+        , staging_bytes_(staging_bytes)
+    {
+        static std::atomic<int> serial{0};
+        const std::string       name = "/ppcp_shm_" + std::to_string(getpid()) + "_" + std::to_string(serial++);
+
+        const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), "shm_open");
+
+        mapped_bytes_ = sizeof(header_t) + staging_bytes_;
+
+        if (ftruncate(fd, off_t(mapped_bytes_)) != 0) {
+            const int err = errno;
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::system_error(err, std::generic_category(), "ftruncate");
+        }
+
+        void *mapped = mmap(nullptr, mapped_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        const int err = errno;
+
+        // the mapping survives fork, the name is not needed anymore
+        close(fd);
+        shm_unlink(name.c_str());
+
+        if (mapped == MAP_FAILED)
+            throw std::system_error(err, std::generic_category(), "mmap");
+
+        header_  = new (mapped) header_t;
+        staging_ = reinterpret_cast<char *>(header_ + 1);
+    }
+
+    ~shm_comm_t() { munmap(header_, mapped_bytes_); }
+
+    shm_comm_t(const shm_comm_t &)            = delete;
+    shm_comm_t &operator=(const shm_comm_t &) = delete;
+
+    int rank() const { return rank_; }
+    int size() const { return size_; }
+
+    // runs worker(comm) on size() processes, the caller becomes rank 0.
+    // a rank that throws aborts the communicator: the others leave their barrier with an exception,
+    // rank 0 kills and reaps every child before it rethrows
+    template <typename worker_t>
+    void spawn(worker_t &&worker)
+    {
+        std::vector<pid_t> children;
+
+        try {
+            for (int rank = 1; rank < size_; rank++) {
+                const pid_t pid = fork();
+
+                if (pid < 0)
+                    throw std::system_error(errno, std::generic_category(), "fork");
+
+                if (pid == 0) {
+                    // never unwind into the caller's code in a child
+                    int status = 0;
+                    try {
+                        rank_ = rank;
+                        worker(*this);
+                    }
+                    catch (...) {
+                        header_->aborted.store(true, std::memory_order_release);
+                        status = 1;
+                    }
+                    _exit(status);
+                }
+
+                children.push_back(pid);
+            }
+
+            worker(*this);
+        }
+        catch (...) {
+            header_->aborted.store(true, std::memory_order_release);
+
+            for (auto pid : children) {
+                kill(pid, SIGKILL);
+                waitpid(pid, nullptr, 0);
+            }
+            throw;
+        }
+
+        bool failed = false;
+        for (auto pid : children) {
+            int status = 0;
+            waitpid(pid, &status, 0);
+            failed |= !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+        }
+
+        if (failed)
+            throw std::runtime_error("shm worker process failed");
+    }
+
+    // sense reversal on a generation counter, throws once any rank has failed instead of waiting for it
+    void barrier()
+    {
+        const unsigned generation = header_->generation.load(std::memory_order_acquire);
+
+        if (header_->arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == size_) {
+            header_->arrived.store(0, std::memory_order_relaxed);
+            header_->generation.store(generation + 1, std::memory_order_release);
+            return;
+        }
+
+        while (header_->generation.load(std::memory_order_acquire) == generation) {
+            if (header_->aborted.load(std::memory_order_acquire))
+                throw std::runtime_error("shm peer process failed");
+            std::this_thread::yield();
+        }
+    }
+
+    // MPI_Bcast
+    template <typename value_t>
+    void broadcast(value_t *data, size_t count, int root)
+    {
+        check_capacity(count * sizeof(value_t));
+
+        if (rank_ == root)
+            std::memcpy(staging_, data, count * sizeof(value_t));
+        barrier();
+
+        if (rank_ != root)
+            std::memcpy(data, staging_, count * sizeof(value_t));
+        barrier();
+    }
+
+    // MPI_Gatherv, counts[r] values of rank r land at recv + sum(counts[0..r))
+    template <typename value_t>
+    void gather(const value_t *send, value_t *recv, const std::vector<size_t> &counts, int root)
+    {
+        std::vector<size_t> displs(counts.size() + 1, 0);
+        for (size_t rank = 0; rank < counts.size(); rank++)
+            displs[rank + 1] = displs[rank] + counts[rank];
+
+        check_capacity(displs.back() * sizeof(value_t));
+
+        value_t *slots = reinterpret_cast<value_t *>(staging_);
+        std::memcpy(slots + displs[rank_], send, counts[rank_] * sizeof(value_t));
+        barrier();
+
+        if (rank_ == root)
+            std::memcpy(recv, slots, displs.back() * sizeof(value_t));
+        barrier();
+    }
+
+private:
+    // lives in the shared mapping, keeps the staging area cache line aligned
+    struct alignas(64) header_t {
+        std::atomic<int>      arrived{0};
+        std::atomic<unsigned> generation{0};
+        std::atomic<bool>     aborted{false};
+    };
+
+    static_assert(std::atomic<int>::is_always_lock_free && std::atomic<unsigned>::is_always_lock_free &&
+                      std::atomic<bool>::is_always_lock_free,
+                  "shared memory atomics must be lock free");
+
+    void check_capacity(size_t bytes) const
+    {
+        if (bytes > staging_bytes_)
+            throw std::length_error("shm staging area too small");
+    }
+
+    int       rank_ = 0;
+    int       size_;
+    size_t    staging_bytes_;
+    size_t    mapped_bytes_ = 0;
+    header_t *header_       = nullptr;
+    char     *staging_      = nullptr;
+};
+
+// b = A*x with the rows split over num_procs processes, each running threads_per_proc threads.
+// a worker only reads its own row block of A; x is broadcast and b gathered through shared memory.
+template <typename value_t, typename index_t>
+void shm_parallel_mult(std::vector<value_t> &A,
+                       std::vector<value_t> &x,
+                       std::vector<value_t> &b,
+                       index_t               m,
+                       index_t               n,
+                       index_t               num_procs        = 2,
+                       index_t               threads_per_proc = 4)
+{
+    const index_t       proc_chunk = SDIV(m, num_procs);
+    std::vector<size_t> counts(num_procs);
+
+    for (index_t rank = 0; rank < num_procs; rank++)
+        counts[rank] = std::min(m, (rank + 1) * proc_chunk) - std::min(m, rank * proc_chunk);
+
+    shm_comm_t world(int(num_procs), sizeof(value_t) * std::max(m, n));
+
+    world.spawn([&](shm_comm_t &comm) -> void {
+        const index_t rank  = index_t(comm.rank());
+        const index_t lower = std::min(m, rank * proc_chunk);
+        const index_t rows  = index_t(counts[rank]);
+
+        std::vector<value_t> x_local(rank == 0 ? x : std::vector<value_t>(n));
+        std::vector<value_t> b_local(rows);
+
+        comm.broadcast(x_local.data(), n, 0);
+
+        auto block = [&](const index_t &id) -> void {
+            const index_t chunk = SDIV(rows, threads_per_proc);
+            const index_t upper = std::min(id * chunk + chunk, rows);
+
+            for (index_t row = id * chunk; row < upper; row++) {
+                value_t accum = value_t(0);
+                for (index_t col = 0; col < n; col++)
+                    accum += A[(lower + row) * n + col] * x_local[col];
+                b_local[row] = accum;
+            }
+        };
+
+        std::vector<std::thread> threads;
+
+        for (index_t id = 0; id < threads_per_proc; id++)
+            threads.emplace_back(block, id);
+
+        for (auto &thread : threads)
+            thread.join();
+
+        comm.gather(b_local.data(), b.data(), counts, 0);
+    });
+}
@@ -0,0 +1,257 @@
+/*********************************************************************
+ * \file   task_allocators.hpp
+ * \brief  std::pmr resources for task-heavy code paths
+ *         a per-thread bump arena with bulk rewind for bookkeeping,
+ *         a fixed-size pool with cross-thread free lists for task state.
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+#include "hpc_helpers.hpp"
+
+//
+// bump arena: an allocation is an aligned pointer increment, deallocate does nothing.
+// rewind / reset hand everything back at once and keep the chunks for the next round,
+// so a steady state loop never reaches upstream. one thread allocates, any thread may deallocate.
+//
+
+class arena_resource_t : public std::pmr::memory_resource {
+public:
+    struct mark_t {
+        size_t chunk;
+        size_t used;
+    };
+
+    explicit arena_resource_t(size_t                     chunk_size = 64 * 1024,
+                              std::pmr::memory_resource *upstream   = std::pmr::get_default_resource())
+        : chunk_size_(chunk_size)
+        , upstream_(upstream)
+    {
+    }
+
+    arena_resource_t(const arena_resource_t &)            = delete;
+    arena_resource_t &operator=(const arena_resource_t &) = delete;
+
+    ~arena_resource_t() override { release(); }
+
+    mark_t mark() const { return {current_, used_}; }
+
+    void rewind(mark_t mark)
+    {
+        current_ = mark.chunk;
+        used_    = mark.used;
+    }
+
+    void reset() { rewind({0, 0}); }
+
+    // chunks back to upstream
+    void release()
+    {
+        for (auto &chunk : chunks_)
+            upstream_->deallocate(chunk.data, chunk.size, alignof(std::max_align_t));
+
+        chunks_.clear();
+        reset();
+    }
+
+private:
+    struct chunk_t {
+        std::byte *data;
+        size_t     size;
+    };
+
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        while (true) {
+            if (current_ < chunks_.size()) {
+                const chunk_t &chunk = chunks_[current_];
+
+                const auto   base   = reinterpret_cast<std::uintptr_t>(chunk.data);
+                const size_t offset = ((base + used_ + alignment - 1) & ~std::uintptr_t(alignment - 1)) - base;
+
+                if (offset <= chunk.size && bytes <= chunk.size - offset) {
+                    used_ = offset + bytes;
+                    return chunk.data + offset;
+                }
+            }
+
+            // kept chunks first, a new one once all of them are used up
+            if (current_ + 1 < chunks_.size()) {
+                current_++;
+                used_ = 0;
+            }
+            else {
+                grow(bytes + alignment);
+            }
+        }
+    }
+
+    void do_deallocate(void *, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    // geometric growth, so a long round needs O(log) chunks
+    void grow(size_t min_size)
+    {
+        const size_t size = std::max(chunk_size_ << std::min<size_t>(chunks_.size(), 10), min_size);
+
+        chunks_.push_back({static_cast<std::byte *>(upstream_->allocate(size, alignof(std::max_align_t))), size});
+        current_ = chunks_.size() - 1;
+        used_    = 0;
+    }
+
+    size_t                     chunk_size_;
+    std::pmr::memory_resource *upstream_;
+    std::vector<chunk_t>       chunks_;
+    size_t                     current_ = 0;
+    size_t                     used_    = 0;
+};
+
+inline arena_resource_t &thread_arena()
+{
+    thread_local arena_resource_t arena;
+    return arena;
+}
+
+// rewinds the arena when the scope ends, containers on it are declared after the scope
+class arena_scope_t {
+public:
+    explicit arena_scope_t(arena_resource_t &arena = thread_arena())
+        : arena_(arena)
+        , mark_(arena.mark())
+    {
+    }
+
+    arena_scope_t(const arena_scope_t &)            = delete;
+    arena_scope_t &operator=(const arena_scope_t &) = delete;
+
+    ~arena_scope_t() { arena_.rewind(mark_); }
+
+    arena_resource_t *resource() { return &arena_; }
+
+private:
+    arena_resource_t        &arena_;
+    arena_resource_t::mark_t mark_;
+};
+
+//
+// fixed-size blocks owned by the thread that created the pool: allocate on the owner only,
+// deallocate from any thread. the owner frees onto a plain local list, other threads push onto
+// an atomic remote list that the owner takes over in one exchange once the local list runs dry.
+// requests larger than a block go upstream. all blocks must be back before the pool is destroyed.
+//
+
+class pool_resource_t : public std::pmr::memory_resource {
+public:
+    explicit pool_resource_t(size_t                     block_size,
+                             size_t                     blocks_per_slab = 256,
+                             std::pmr::memory_resource *upstream        = std::pmr::get_default_resource())
+        : block_size_(SDIV(std::max(block_size, sizeof(node_t)), alignof(std::max_align_t)) *
+                      alignof(std::max_align_t))
+        , blocks_per_slab_(blocks_per_slab)
+        , upstream_(upstream)
+        , owner_(std::this_thread::get_id())
+    {
+    }
+
+    pool_resource_t(const pool_resource_t &)            = delete;
+    pool_resource_t &operator=(const pool_resource_t &) = delete;
+
+    ~pool_resource_t() override
+    {
+        for (auto slab : slabs_)
+            upstream_->deallocate(slab, block_size_ * blocks_per_slab_, alignof(std::max_align_t));
+    }
+
+    size_t block_size() const { return block_size_; }
+
+private:
+    struct node_t {
+        node_t *next;
+    };
+
+    bool pooled(size_t bytes, size_t alignment) const
+    {
+        return bytes <= block_size_ && alignment <= alignof(std::max_align_t);
+    }
+
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        if (!pooled(bytes, alignment))
+            return upstream_->allocate(bytes, alignment);
+
+        assert(std::this_thread::get_id() == owner_);
+
+        if (local_ == nullptr)
+            local_ = remote_.exchange(nullptr, std::memory_order_acquire);
+        if (local_ == nullptr)
+            carve();
+
+        node_t *node = local_;
+        local_       = node->next;
+        return node;
+    }
+
+    void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
+    {
+        if (!pooled(bytes, alignment)) {
+            upstream_->deallocate(ptr, bytes, alignment);
+            return;
+        }
+
+        node_t *node = static_cast<node_t *>(ptr);
+
+        if (std::this_thread::get_id() == owner_) {
+            node->next = local_;
+            local_     = node;
+            return;
+        }
+
+        // push only, the owner takes the whole list: no ABA
+        node->next = remote_.load(std::memory_order_relaxed);
+        while (!remote_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed))
+            ;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+    void carve()
+    {
+        auto *slab =
+            static_cast<std::byte *>(upstream_->allocate(block_size_ * blocks_per_slab_, alignof(std::max_align_t)));
+        slabs_.push_back(slab);
+
+        for (size_t block = blocks_per_slab_; block-- != 0;) {
+            node_t *node = reinterpret_cast<node_t *>(slab + block * block_size_);
+            node->next   = local_;
+            local_       = node;
+        }
+    }
+
+    size_t                     block_size_;
+    size_t                     blocks_per_slab_;
+    std::pmr::memory_resource *upstream_;
+    std::thread::id            owner_;
+
+    node_t                  *local_ = nullptr;
+    std::vector<std::byte *> slabs_;
+
+    // remote frees do not share a line with the owner's list
+    alignas(64) std::atomic<node_t *> remote_{nullptr};
+};
+
+// promise shared state and result storage both fit one block (56 and 32 bytes on libstdc++),
+// larger states of other libraries still work, they just go upstream
+constexpr size_t TASK_STATE_SIZE = 64;
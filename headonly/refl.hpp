@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <type_traits>
+#include <utility>
 
 namespace REFL
 {
@@ -11,7 +13,7 @@ namespace DETAIL
 // max members
 //
 
-constexpr size_t MaxClassMembers = 16;
+constexpr size_t MaxClassMembers = 64;
 
 //
 // type system
@@ -94,6 +96,37 @@ struct IsMapTypeImpl<_Ty, std::void_t<typename RemoveCVRType<_Ty>::mapped_type>>
 template <typename _Ty>
 constexpr bool IsMapType = IsContainerType<_Ty> &&IsMapTypeImpl<_Ty>::value;
 
+//
+// contiguous container -> _Ty::data()
+//
+
+template <typename _Ty, typename = void>
+struct IsContiguousImpl : std::false_type {
+};
+
+template <typename _Ty>
+struct IsContiguousImpl<_Ty, std::void_t<decltype(std::declval<_Ty &>().data())>> : std::true_type {
+};
+
+//
+// resizable container -> _Ty::resize(size_t)
+//
+
+template <typename _Ty, typename = void>
+struct IsResizableImpl : std::false_type {
+};
+
+template <typename _Ty>
+struct IsResizableImpl<_Ty, std::void_t<decltype(std::declval<_Ty &>().resize(size_t()))>> : std::true_type {
+};
+
+//
+// static_assert(AlwaysFalse<_Ty>) in the last if constexpr branch
+//
+
+template <typename _Ty>
+constexpr bool AlwaysFalse = false;
+
 //
 // User defined reflect type -> _Ty::REFL::MAKE_FLAG <==> _Ty&
 //
@@ -105,13 +138,36 @@ struct IsUserReflImpl : std::false_type {
 template <typename _Ty>
 struct IsUserReflImpl<_Ty,
                       std::void_t<std::enable_if_t<
-                          std::is_same_v<decltype(typename _Ty::REFL::MAKE_FLAG(std::declval<_Ty &>())), _Ty &>>>>
+                          std::is_same_v<decltype(_Ty::REFL::MAKE_FLAG(std::declval<_Ty &>())), _Ty &>>>>
     : std::true_type {
 };
 
 template <typename _Ty>
 constexpr bool IsUserRefl = IsUserReflImpl<_Ty>::value;
 
+//
+// tuple like -> std::tuple_size<_Ty>, std::array / std::pair / std::tuple: elements, not bindings
+//
+
+template <typename _Ty, typename = void>
+struct IsTupleLikeImpl : std::false_type {
+};
+
+template <typename _Ty>
+struct IsTupleLikeImpl<_Ty, std::void_t<decltype(std::tuple_size<_Ty>::value)>> : std::true_type {
+};
+
+template <typename _Ty>
+constexpr bool IsTupleLike = IsTupleLikeImpl<_Ty>::value;
+
+//
+// Visits() compiles -> MAKE_REFL class or a plain aggregate struct
+//
+
+template <typename _Ty>
+constexpr bool IsVisitable =
+    IsUserRefl<_Ty> || (std::is_class_v<_Ty> && std::is_aggregate_v<_Ty> && !IsTupleLike<_Ty>);
+
 //
 // get type id
 //
@@ -180,26 +236,287 @@ struct UniversalType {
     }
 };
 
-template <typename _Ty, typename _Initializer, typename = void, typename... _Args>
-struct IsInitializerTypeImpl : std::false_type {
+template <size_t>
+using IndexedUniversalType = UniversalType;
+
+template <typename _Ty, typename _Indices, typename = void>
+struct IsInitializableImpl : std::false_type {
 };
-template <typename _Ty, typename _Initializer, typename... _Args>
-struct IsInitializerTypeImpl<_Ty, _Initializer, std::void_t<decltype(_Ty{{_Args{}}..., {_Initializer{}}})>, _Args...>
+template <typename _Ty, size_t... _I>
+struct IsInitializableImpl<_Ty, std::index_sequence<_I...>, std::void_t<decltype(_Ty{{IndexedUniversalType<_I>{}}...})>>
     : std::true_type {
 };
-template <typename _Ty, typename _Initializer, typename... _Args>
-constexpr bool IsInitializerType = DETAIL::IsInitializerTypeImpl<_Ty, _Initializer, void, _Args...>::value;
+
+//
+// _Ty{{u1}, ..., {uN}} compiles
+//
+
+template <typename _Ty, size_t _Count>
+constexpr bool IsInitializable = IsInitializableImpl<_Ty, std::make_index_sequence<_Count>>::value;
+
+//
+// structured binding per member count, one specialization each up to MaxClassMembers
+//
+
+template <size_t _Count>
+struct StructVisitor;
+
+template <>
+struct StructVisitor<0> {
+    template <typename _Ty, typename _Visitor>
+    static constexpr decltype(auto) Visit(_Ty &, _Visitor &&Visitor)
+    {
+        return Visitor();
+    }
+};
+
+#define REFL_BINDINGS1 p1
+#define REFL_BINDINGS2 REFL_BINDINGS1, p2
+#define REFL_BINDINGS3 REFL_BINDINGS2, p3
+#define REFL_BINDINGS4 REFL_BINDINGS3, p4
+#define REFL_BINDINGS5 REFL_BINDINGS4, p5
+#define REFL_BINDINGS6 REFL_BINDINGS5, p6
+#define REFL_BINDINGS7 REFL_BINDINGS6, p7
+#define REFL_BINDINGS8 REFL_BINDINGS7, p8
+#define REFL_BINDINGS9 REFL_BINDINGS8, p9
+#define REFL_BINDINGS10 REFL_BINDINGS9, p10
+#define REFL_BINDINGS11 REFL_BINDINGS10, p11
+#define REFL_BINDINGS12 REFL_BINDINGS11, p12
+#define REFL_BINDINGS13 REFL_BINDINGS12, p13
+#define REFL_BINDINGS14 REFL_BINDINGS13, p14
+#define REFL_BINDINGS15 REFL_BINDINGS14, p15
+#define REFL_BINDINGS16 REFL_BINDINGS15, p16
+#define REFL_BINDINGS17 REFL_BINDINGS16, p17
+#define REFL_BINDINGS18 REFL_BINDINGS17, p18
+#define REFL_BINDINGS19 REFL_BINDINGS18, p19
+#define REFL_BINDINGS20 REFL_BINDINGS19, p20
+#define REFL_BINDINGS21 REFL_BINDINGS20, p21
+#define REFL_BINDINGS22 REFL_BINDINGS21, p22
+#define REFL_BINDINGS23 REFL_BINDINGS22, p23
+#define REFL_BINDINGS24 REFL_BINDINGS23, p24
+#define REFL_BINDINGS25 REFL_BINDINGS24, p25
+#define REFL_BINDINGS26 REFL_BINDINGS25, p26
+#define REFL_BINDINGS27 REFL_BINDINGS26, p27
+#define REFL_BINDINGS28 REFL_BINDINGS27, p28
+#define REFL_BINDINGS29 REFL_BINDINGS28, p29
+#define REFL_BINDINGS30 REFL_BINDINGS29, p30
+#define REFL_BINDINGS31 REFL_BINDINGS30, p31
+#define REFL_BINDINGS32 REFL_BINDINGS31, p32
+#define REFL_BINDINGS33 REFL_BINDINGS32, p33
+#define REFL_BINDINGS34 REFL_BINDINGS33, p34
+#define REFL_BINDINGS35 REFL_BINDINGS34, p35
+#define REFL_BINDINGS36 REFL_BINDINGS35, p36
+#define REFL_BINDINGS37 REFL_BINDINGS36, p37
+#define REFL_BINDINGS38 REFL_BINDINGS37, p38
+#define REFL_BINDINGS39 REFL_BINDINGS38, p39
+#define REFL_BINDINGS40 REFL_BINDINGS39, p40
+#define REFL_BINDINGS41 REFL_BINDINGS40, p41
+#define REFL_BINDINGS42 REFL_BINDINGS41, p42
+#define REFL_BINDINGS43 REFL_BINDINGS42, p43
+#define REFL_BINDINGS44 REFL_BINDINGS43, p44
+#define REFL_BINDINGS45 REFL_BINDINGS44, p45
+#define REFL_BINDINGS46 REFL_BINDINGS45, p46
+#define REFL_BINDINGS47 REFL_BINDINGS46, p47
+#define REFL_BINDINGS48 REFL_BINDINGS47, p48
+#define REFL_BINDINGS49 REFL_BINDINGS48, p49
+#define REFL_BINDINGS50 REFL_BINDINGS49, p50
+#define REFL_BINDINGS51 REFL_BINDINGS50, p51
+#define REFL_BINDINGS52 REFL_BINDINGS51, p52
+#define REFL_BINDINGS53 REFL_BINDINGS52, p53
+#define REFL_BINDINGS54 REFL_BINDINGS53, p54
+#define REFL_BINDINGS55 REFL_BINDINGS54, p55
+#define REFL_BINDINGS56 REFL_BINDINGS55, p56
+#define REFL_BINDINGS57 REFL_BINDINGS56, p57
+#define REFL_BINDINGS58 REFL_BINDINGS57, p58
+#define REFL_BINDINGS59 REFL_BINDINGS58, p59
+#define REFL_BINDINGS60 REFL_BINDINGS59, p60
+#define REFL_BINDINGS61 REFL_BINDINGS60, p61
+#define REFL_BINDINGS62 REFL_BINDINGS61, p62
+#define REFL_BINDINGS63 REFL_BINDINGS62, p63
+#define REFL_BINDINGS64 REFL_BINDINGS63, p64
+
+#define REFL_STRUCT_VISITOR(_Count)                                                                                    \
+    template <>                                                                                                        \
+    struct StructVisitor<_Count> {                                                                                     \
+        template <typename _Ty, typename _Visitor>                                                                     \
+        static constexpr decltype(auto) Visit(_Ty &Object, _Visitor &&Visitor)                                         \
+        {                                                                                                              \
+            auto &&[REFL_BINDINGS##_Count] = Object;                                                                   \
+            return Visitor(REFL_BINDINGS##_Count);                                                                     \
+        }                                                                                                              \
+    };
+
+REFL_STRUCT_VISITOR(1)
+REFL_STRUCT_VISITOR(2)
+REFL_STRUCT_VISITOR(3)
+REFL_STRUCT_VISITOR(4)
+REFL_STRUCT_VISITOR(5)
+REFL_STRUCT_VISITOR(6)
+REFL_STRUCT_VISITOR(7)
+REFL_STRUCT_VISITOR(8)
+REFL_STRUCT_VISITOR(9)
+REFL_STRUCT_VISITOR(10)
+REFL_STRUCT_VISITOR(11)
+REFL_STRUCT_VISITOR(12)
+REFL_STRUCT_VISITOR(13)
+REFL_STRUCT_VISITOR(14)
+REFL_STRUCT_VISITOR(15)
+REFL_STRUCT_VISITOR(16)
+REFL_STRUCT_VISITOR(17)
+REFL_STRUCT_VISITOR(18)
+REFL_STRUCT_VISITOR(19)
+REFL_STRUCT_VISITOR(20)
+REFL_STRUCT_VISITOR(21)
+REFL_STRUCT_VISITOR(22)
+REFL_STRUCT_VISITOR(23)
+REFL_STRUCT_VISITOR(24)
+REFL_STRUCT_VISITOR(25)
+REFL_STRUCT_VISITOR(26)
+REFL_STRUCT_VISITOR(27)
+REFL_STRUCT_VISITOR(28)
+REFL_STRUCT_VISITOR(29)
+REFL_STRUCT_VISITOR(30)
+REFL_STRUCT_VISITOR(31)
+REFL_STRUCT_VISITOR(32)
+REFL_STRUCT_VISITOR(33)
+REFL_STRUCT_VISITOR(34)
+REFL_STRUCT_VISITOR(35)
+REFL_STRUCT_VISITOR(36)
+REFL_STRUCT_VISITOR(37)
+REFL_STRUCT_VISITOR(38)
+REFL_STRUCT_VISITOR(39)
+REFL_STRUCT_VISITOR(40)
+REFL_STRUCT_VISITOR(41)
+REFL_STRUCT_VISITOR(42)
+REFL_STRUCT_VISITOR(43)
+REFL_STRUCT_VISITOR(44)
+REFL_STRUCT_VISITOR(45)
+REFL_STRUCT_VISITOR(46)
+REFL_STRUCT_VISITOR(47)
+REFL_STRUCT_VISITOR(48)
+REFL_STRUCT_VISITOR(49)
+REFL_STRUCT_VISITOR(50)
+REFL_STRUCT_VISITOR(51)
+REFL_STRUCT_VISITOR(52)
+REFL_STRUCT_VISITOR(53)
+REFL_STRUCT_VISITOR(54)
+REFL_STRUCT_VISITOR(55)
+REFL_STRUCT_VISITOR(56)
+REFL_STRUCT_VISITOR(57)
+REFL_STRUCT_VISITOR(58)
+REFL_STRUCT_VISITOR(59)
+REFL_STRUCT_VISITOR(60)
+REFL_STRUCT_VISITOR(61)
+REFL_STRUCT_VISITOR(62)
+REFL_STRUCT_VISITOR(63)
+REFL_STRUCT_VISITOR(64)
+
+#undef REFL_STRUCT_VISITOR
+#undef REFL_BINDINGS1
+#undef REFL_BINDINGS2
+#undef REFL_BINDINGS3
+#undef REFL_BINDINGS4
+#undef REFL_BINDINGS5
+#undef REFL_BINDINGS6
+#undef REFL_BINDINGS7
+#undef REFL_BINDINGS8
+#undef REFL_BINDINGS9
+#undef REFL_BINDINGS10
+#undef REFL_BINDINGS11
+#undef REFL_BINDINGS12
+#undef REFL_BINDINGS13
+#undef REFL_BINDINGS14
+#undef REFL_BINDINGS15
+#undef REFL_BINDINGS16
+#undef REFL_BINDINGS17
+#undef REFL_BINDINGS18
+#undef REFL_BINDINGS19
+#undef REFL_BINDINGS20
+#undef REFL_BINDINGS21
+#undef REFL_BINDINGS22
+#undef REFL_BINDINGS23
+#undef REFL_BINDINGS24
+#undef REFL_BINDINGS25
+#undef REFL_BINDINGS26
+#undef REFL_BINDINGS27
+#undef REFL_BINDINGS28
+#undef REFL_BINDINGS29
+#undef REFL_BINDINGS30
+#undef REFL_BINDINGS31
+#undef REFL_BINDINGS32
+#undef REFL_BINDINGS33
+#undef REFL_BINDINGS34
+#undef REFL_BINDINGS35
+#undef REFL_BINDINGS36
+#undef REFL_BINDINGS37
+#undef REFL_BINDINGS38
+#undef REFL_BINDINGS39
+#undef REFL_BINDINGS40
+#undef REFL_BINDINGS41
+#undef REFL_BINDINGS42
+#undef REFL_BINDINGS43
+#undef REFL_BINDINGS44
+#undef REFL_BINDINGS45
+#undef REFL_BINDINGS46
+#undef REFL_BINDINGS47
+#undef REFL_BINDINGS48
+#undef REFL_BINDINGS49
+#undef REFL_BINDINGS50
+#undef REFL_BINDINGS51
+#undef REFL_BINDINGS52
+#undef REFL_BINDINGS53
+#undef REFL_BINDINGS54
+#undef REFL_BINDINGS55
+#undef REFL_BINDINGS56
+#undef REFL_BINDINGS57
+#undef REFL_BINDINGS58
+#undef REFL_BINDINGS59
+#undef REFL_BINDINGS60
+#undef REFL_BINDINGS61
+#undef REFL_BINDINGS62
+#undef REFL_BINDINGS63
+#undef REFL_BINDINGS64
 
 struct ADL {
 
-    template <typename _Ty, typename... _Args>
+    //
+    // _Lower initializes, _Upper does not: bisect to the largest count that does
+    //
+
+    template <typename _Ty, size_t _Lower, size_t _Upper>
+    static constexpr std::size_t bisect_counts()
+    {
+        if constexpr (_Upper - _Lower == 1) {
+            return _Lower;
+        }
+        else {
+            constexpr size_t _Middle = _Lower + (_Upper - _Lower) / 2;
+
+            if constexpr (IsInitializable<_Ty, _Middle>) {
+                return bisect_counts<_Ty, _Middle, _Upper>();
+            }
+            else {
+                return bisect_counts<_Ty, _Lower, _Middle>();
+            }
+        }
+    }
+
+    //
+    // probe 1, 2, 4, ... until initialization fails, then bisect: O(log N) probes, none wider than 2N.
+    // capped one above MaxClassMembers so that too wide structures still fail the static_assert below.
+    //
+
+    template <typename _Ty, size_t _Lower = 0, size_t _Upper = 1>
     static constexpr std::size_t counts_impl()
     {
-        if constexpr (DETAIL::IsInitializerType<_Ty, UniversalType, _Args...>) {
-            return counts_impl<_Ty, _Args..., UniversalType>();
+        if constexpr (!IsInitializable<_Ty, _Upper>) {
+            return bisect_counts<_Ty, _Lower, _Upper>();
+        }
+        else if constexpr (_Upper > MaxClassMembers) {
+            return _Upper;
         }
         else {
-            return sizeof...(_Args);
+            return counts_impl<_Ty, _Upper, (2 * _Upper <= MaxClassMembers ? 2 * _Upper : MaxClassMembers + 1)>();
         }
     }
 
@@ -208,73 +525,7 @@ struct ADL {
     {
         static_assert(_Count <= MaxClassMembers, "Too many structure members.");
 
-        if constexpr (_Count == 0) {
-            return Visitor();
-        }
-        else if constexpr (_Count == 1) {
-            auto &&[p1] = Object;
-            return Visitor(p1);
-        }
-        else if constexpr (_Count == 2) {
-            auto &&[p1, p2] = Object;
-            return Visitor(p1, p2);
-        }
-        else if constexpr (_Count == 3) {
-            auto &&[p1, p2, p3] = Object;
-            return Visitor(p1, p2, p3);
-        }
-        else if constexpr (_Count == 4) {
-            auto &&[p1, p2, p3, p4] = Object;
-            return Visitor(p1, p2, p3, p4);
-        }
-        else if constexpr (_Count == 5) {
-            auto &&[p1, p2, p3, p4, p5] = Object;
-            return Visitor(p1, p2, p3, p4, p5);
-        }
-        else if constexpr (_Count == 6) {
-            auto &&[p1, p2, p3, p4, p5, p6] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6);
-        }
-        else if constexpr (_Count == 7) {
-            auto &&[p1, p2, p3, p4, p5, p6, p7] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6, p7);
-        }
-        else if constexpr (_Count == 8) {
-            auto &&[p1, p2, p3, p4, p5, p6, p7, p8] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6, p7, p8);
-        }
-        else if constexpr (_Count == 9) {
-            auto &&[p1, p2, p3, p4, p5, p6, p7, p8, p9] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6, p7, p8, p9);
-        }
-        else if constexpr (_Count == 10) {
-            auto &&[p1, p2, p3, p4, p5, p6, p7, p8, p9, p10] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10);
-        }
-        else if constexpr (_Count == 11) {
-            auto &&[p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11);
-        }
-        else if constexpr (_Count == 12) {
-            auto &&[p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12);
-        }
-        else if constexpr (_Count == 13) {
-            auto &&[p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13);
-        }
-        else if constexpr (_Count == 14) {
-            auto &&[p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14);
-        }
-        else if constexpr (_Count == 15) {
-            auto &&[p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15);
-        }
-        else if constexpr (_Count == 16) {
-            auto &&[p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16] = Object;
-            return Visitor(p1, p2, p3, p4, p5, p6, p7, p8, p9, p10, p11, p12, p13, p14, p15, p16);
-        }
+        return StructVisitor<_Count>::Visit(Object, std::forward<_Visitor>(Visitor));
     }
 
     template <size_t _Count, typename _Object, typename _Visitor>
@@ -282,174 +533,8 @@ struct ADL {
     {
         static_assert(_Count <= MaxClassMembers, "exceed max visit members");
 
-        if constexpr (_Count == 0) {
-            return Visitor();
-        }
-        else if constexpr (_Count == 1) {
-            return Visitor(Object.REFL::GET_0(Object));
-        }
-        else if constexpr (_Count == 2) {
-            return Visitor(Object.REFL::GET_0(Object), Object.REFL::GET_1(Object));
-        }
-        else if constexpr (_Count == 3) {
-            return Visitor(Object.REFL::GET_0(Object), Object.REFL::GET_1(Object), Object.REFL::GET_2(Object));
-        }
-        else if constexpr (_Count == 4) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object));
-        }
-        else if constexpr (_Count == 5) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object));
-        }
-        else if constexpr (_Count == 6) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object));
-        }
-        else if constexpr (_Count == 7) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object),
-                           Object.REFL::GET_6(Object));
-        }
-        else if constexpr (_Count == 8) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object),
-                           Object.REFL::GET_6(Object),
-                           Object.REFL::GET_7(Object));
-        }
-        else if constexpr (_Count == 9) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object),
-                           Object.REFL::GET_6(Object),
-                           Object.REFL::GET_7(Object),
-                           Object.REFL::GET_8(Object));
-        }
-        else if constexpr (_Count == 10) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object),
-                           Object.REFL::GET_6(Object),
-                           Object.REFL::GET_7(Object),
-                           Object.REFL::GET_8(Object),
-                           Object.REFL::GET_9(Object));
-        }
-        else if constexpr (_Count == 11) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object),
-                           Object.REFL::GET_6(Object),
-                           Object.REFL::GET_7(Object),
-                           Object.REFL::GET_8(Object),
-                           Object.REFL::GET_9(Object),
-                           Object.REFL::GET_10(Object));
-        }
-        else if constexpr (_Count == 12) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object),
-                           Object.REFL::GET_6(Object),
-                           Object.REFL::GET_7(Object),
-                           Object.REFL::GET_8(Object),
-                           Object.REFL::GET_9(Object),
-                           Object.REFL::GET_10(Object),
-                           Object.REFL::GET_11(Object));
-        }
-        else if constexpr (_Count == 13) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object),
-                           Object.REFL::GET_6(Object),
-                           Object.REFL::GET_7(Object),
-                           Object.REFL::GET_8(Object),
-                           Object.REFL::GET_9(Object),
-                           Object.REFL::GET_10(Object),
-                           Object.REFL::GET_11(Object),
-                           Object.REFL::GET_12(Object));
-        }
-        else if constexpr (_Count == 14) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object),
-                           Object.REFL::GET_6(Object),
-                           Object.REFL::GET_7(Object),
-                           Object.REFL::GET_8(Object),
-                           Object.REFL::GET_9(Object),
-                           Object.REFL::GET_10(Object),
-                           Object.REFL::GET_11(Object),
-                           Object.REFL::GET_12(Object),
-                           Object.REFL::GET_13(Object));
-        }
-        else if constexpr (_Count == 15) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object),
-                           Object.REFL::GET_6(Object),
-                           Object.REFL::GET_7(Object),
-                           Object.REFL::GET_8(Object),
-                           Object.REFL::GET_9(Object),
-                           Object.REFL::GET_10(Object),
-                           Object.REFL::GET_11(Object),
-                           Object.REFL::GET_12(Object),
-                           Object.REFL::GET_13(Object),
-                           Object.REFL::GET_14(Object));
-        }
-        else if constexpr (_Count == 16) {
-            return Visitor(Object.REFL::GET_0(Object),
-                           Object.REFL::GET_1(Object),
-                           Object.REFL::GET_2(Object),
-                           Object.REFL::GET_3(Object),
-                           Object.REFL::GET_4(Object),
-                           Object.REFL::GET_5(Object),
-                           Object.REFL::GET_6(Object),
-                           Object.REFL::GET_7(Object),
-                           Object.REFL::GET_8(Object),
-                           Object.REFL::GET_9(Object),
-                           Object.REFL::GET_10(Object),
-                           Object.REFL::GET_11(Object),
-                           Object.REFL::GET_12(Object),
-                           Object.REFL::GET_13(Object),
-                           Object.REFL::GET_14(Object),
-                           Object.REFL::GET_15(Object));
-        }
+        // spelled through the type: inside namespace REFL, Object.REFL:: names the namespace
+        return RemoveCVRType<_Object>::REFL::VISIT(Object, std::forward<_Visitor>(Visitor));
     }
 };
 
@@ -468,7 +553,7 @@ constexpr size_t Counts()
     using Type = DETAIL::RemoveCVRType<_Ty>;
 
     if constexpr (DETAIL::IsUserRefl<Type>) {
-        return typename _Ty::REFL::COUNTS();
+        return Type::REFL::COUNTS();
     }
     else {
         return DETAIL::ADL::counts_impl<Type>();
@@ -506,37 +591,149 @@ void Foreach(_Ty &&Object, _Func &&Func)
         [&](auto &&...Items) constexpr { (Func(Items), ...); });
 }
 
+//
+// padding free -> trivially copyable and the object bytes are exactly its visited members,
+// such objects can be copied / hashed / compared as raw bytes.
+//
+
+namespace DETAIL
+{
+
+template <typename _Ty>
+constexpr size_t PackedSize();
+
+struct PackedSizeVisitor {
+    template <typename... _Args>
+    constexpr auto operator()(_Args &&...) const
+    {
+        return std::integral_constant<size_t, (size_t(0) + ... + PackedSize<RemoveCVRType<_Args>>())>{};
+    }
+};
+
+template <typename _Ty, size_t... _I>
+constexpr size_t PackedTupleSize(std::index_sequence<_I...>)
+{
+    return (size_t(0) + ... + PackedSize<std::tuple_element_t<_I, _Ty>>());
+}
+
+template <typename _Ty>
+constexpr size_t PackedSize()
+{
+    if constexpr (std::is_arithmetic_v<_Ty> || std::is_enum_v<_Ty>) {
+        return sizeof(_Ty);
+    }
+    else if constexpr (std::is_array_v<_Ty>) {
+        return std::extent_v<_Ty> * PackedSize<std::remove_extent_t<_Ty>>();
+    }
+    else if constexpr (IsTupleLike<_Ty> && std::is_trivially_copyable_v<_Ty>) {
+        return PackedTupleSize<_Ty>(std::make_index_sequence<std::tuple_size_v<_Ty>>());
+    }
+    else if constexpr (IsVisitable<_Ty> && std::is_trivially_copyable_v<_Ty>) {
+        return decltype(Visits(std::declval<_Ty &>(), PackedSizeVisitor{}))::value;
+    }
+
+    return 0;
+}
+
+} // namespace DETAIL
+
+template <typename _Ty>
+constexpr bool IsPaddingFree = std::is_trivially_copyable_v<_Ty> && DETAIL::PackedSize<_Ty>() == sizeof(_Ty);
+
 //
 // Object macro refl
 //
 
 #define REFL_ARG_COUNT(...)                                                                                            \
-    REFL_MARCO_EXPAND(REFL_INTERNAL_ARG_COUNT(0, ##__VA_ARGS__, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0))
-
-#define REFL_INTERNAL_ARG_COUNT(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, N, ...) N
+    REFL_MARCO_EXPAND(REFL_INTERNAL_ARG_COUNT(0, ##__VA_ARGS__,                                                        \
+                                              64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49,          \
+                                              48, 47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33,          \
+                                              32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,          \
+                                              16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1,                   \
+                                              0))
+
+#define REFL_INTERNAL_ARG_COUNT(_0, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15,                  \
+                                _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31,        \
+                                _32, _33, _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47,        \
+                                _48, _49, _50, _51, _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63,        \
+                                _64,                                                                                   \
+                                N, ...)                                                                                \
+    N
 
 #define REFL_CONCAT_(l, r) l##r
 #define REFL_CONCAT(l, r)  REFL_CONCAT_(l, r)
 
 #define REFL_MARCO_EXPAND(...) __VA_ARGS__
 
+//
+// f(index, t) for each argument, last argument first, each preceded by s
+//
+
 #define REFL_DOARG0(s, f, o)
-#define REFL_DOARG1(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG0(s, f, __VA_ARGS__)) s f(0, t)
-#define REFL_DOARG2(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG1(s, f, __VA_ARGS__)) s f(1, t)
-#define REFL_DOARG3(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG2(s, f, __VA_ARGS__)) s f(2, t)
-#define REFL_DOARG4(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG3(s, f, __VA_ARGS__)) s f(3, t)
-#define REFL_DOARG5(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG4(s, f, __VA_ARGS__)) s f(4, t)
-#define REFL_DOARG6(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG5(s, f, __VA_ARGS__)) s f(5, t)
-#define REFL_DOARG7(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG6(s, f, __VA_ARGS__)) s f(6, t)
-#define REFL_DOARG8(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG7(s, f, __VA_ARGS__)) s f(7, t)
-#define REFL_DOARG9(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG8(s, f, __VA_ARGS__)) s f(8, t)
-#define REFL_DOARG10(s, f, t, ...) REFL_MARCO_EXPAND(REFL_DOARG9(s, f, __VA_ARGS__)) s f(9, t)
-#define REFL_DOARG11(s, f, t, ...) REFL_MARCO_EXPAND(REFL_DOARG10(s, f, __VA_ARGS__)) s f(10, t)
-#define REFL_DOARG12(s, f, t, ...) REFL_MARCO_EXPAND(REFL_DOARG11(s, f, __VA_ARGS__)) s f(11, t)
-#define REFL_DOARG13(s, f, t, ...) REFL_MARCO_EXPAND(REFL_DOARG12(s, f, __VA_ARGS__)) s f(12, t)
-#define REFL_DOARG14(s, f, t, ...) REFL_MARCO_EXPAND(REFL_DOARG13(s, f, __VA_ARGS__)) s f(13, t)
-#define REFL_DOARG15(s, f, t, ...) REFL_MARCO_EXPAND(REFL_DOARG14(s, f, __VA_ARGS__)) s f(14, t)
-#define REFL_DOARG16(s, f, t, ...) REFL_MARCO_EXPAND(REFL_DOARG15(s, f, __VA_ARGS__)) s f(15, t)
+#define REFL_DOARG1(s, f, t, ...)   REFL_MARCO_EXPAND(REFL_DOARG0(s, f, __VA_ARGS__)) s f(0, t)
+#define REFL_DOARG2(s, f, t, ...)   REFL_MARCO_EXPAND(REFL_DOARG1(s, f, __VA_ARGS__)) s f(1, t)
+#define REFL_DOARG3(s, f, t, ...)   REFL_MARCO_EXPAND(REFL_DOARG2(s, f, __VA_ARGS__)) s f(2, t)
+#define REFL_DOARG4(s, f, t, ...)   REFL_MARCO_EXPAND(REFL_DOARG3(s, f, __VA_ARGS__)) s f(3, t)
+#define REFL_DOARG5(s, f, t, ...)   REFL_MARCO_EXPAND(REFL_DOARG4(s, f, __VA_ARGS__)) s f(4, t)
+#define REFL_DOARG6(s, f, t, ...)   REFL_MARCO_EXPAND(REFL_DOARG5(s, f, __VA_ARGS__)) s f(5, t)
+#define REFL_DOARG7(s, f, t, ...)   REFL_MARCO_EXPAND(REFL_DOARG6(s, f, __VA_ARGS__)) s f(6, t)
+#define REFL_DOARG8(s, f, t, ...)   REFL_MARCO_EXPAND(REFL_DOARG7(s, f, __VA_ARGS__)) s f(7, t)
+#define REFL_DOARG9(s, f, t, ...)   REFL_MARCO_EXPAND(REFL_DOARG8(s, f, __VA_ARGS__)) s f(8, t)
+#define REFL_DOARG10(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG9(s, f, __VA_ARGS__)) s f(9, t)
+#define REFL_DOARG11(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG10(s, f, __VA_ARGS__)) s f(10, t)
+#define REFL_DOARG12(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG11(s, f, __VA_ARGS__)) s f(11, t)
+#define REFL_DOARG13(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG12(s, f, __VA_ARGS__)) s f(12, t)
+#define REFL_DOARG14(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG13(s, f, __VA_ARGS__)) s f(13, t)
+#define REFL_DOARG15(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG14(s, f, __VA_ARGS__)) s f(14, t)
+#define REFL_DOARG16(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG15(s, f, __VA_ARGS__)) s f(15, t)
+#define REFL_DOARG17(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG16(s, f, __VA_ARGS__)) s f(16, t)
+#define REFL_DOARG18(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG17(s, f, __VA_ARGS__)) s f(17, t)
+#define REFL_DOARG19(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG18(s, f, __VA_ARGS__)) s f(18, t)
+#define REFL_DOARG20(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG19(s, f, __VA_ARGS__)) s f(19, t)
+#define REFL_DOARG21(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG20(s, f, __VA_ARGS__)) s f(20, t)
+#define REFL_DOARG22(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG21(s, f, __VA_ARGS__)) s f(21, t)
+#define REFL_DOARG23(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG22(s, f, __VA_ARGS__)) s f(22, t)
+#define REFL_DOARG24(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG23(s, f, __VA_ARGS__)) s f(23, t)
+#define REFL_DOARG25(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG24(s, f, __VA_ARGS__)) s f(24, t)
+#define REFL_DOARG26(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG25(s, f, __VA_ARGS__)) s f(25, t)
+#define REFL_DOARG27(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG26(s, f, __VA_ARGS__)) s f(26, t)
+#define REFL_DOARG28(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG27(s, f, __VA_ARGS__)) s f(27, t)
+#define REFL_DOARG29(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG28(s, f, __VA_ARGS__)) s f(28, t)
+#define REFL_DOARG30(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG29(s, f, __VA_ARGS__)) s f(29, t)
+#define REFL_DOARG31(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG30(s, f, __VA_ARGS__)) s f(30, t)
+#define REFL_DOARG32(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG31(s, f, __VA_ARGS__)) s f(31, t)
+#define REFL_DOARG33(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG32(s, f, __VA_ARGS__)) s f(32, t)
+#define REFL_DOARG34(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG33(s, f, __VA_ARGS__)) s f(33, t)
+#define REFL_DOARG35(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG34(s, f, __VA_ARGS__)) s f(34, t)
+#define REFL_DOARG36(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG35(s, f, __VA_ARGS__)) s f(35, t)
+#define REFL_DOARG37(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG36(s, f, __VA_ARGS__)) s f(36, t)
+#define REFL_DOARG38(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG37(s, f, __VA_ARGS__)) s f(37, t)
+#define REFL_DOARG39(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG38(s, f, __VA_ARGS__)) s f(38, t)
+#define REFL_DOARG40(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG39(s, f, __VA_ARGS__)) s f(39, t)
+#define REFL_DOARG41(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG40(s, f, __VA_ARGS__)) s f(40, t)
+#define REFL_DOARG42(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG41(s, f, __VA_ARGS__)) s f(41, t)
+#define REFL_DOARG43(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG42(s, f, __VA_ARGS__)) s f(42, t)
+#define REFL_DOARG44(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG43(s, f, __VA_ARGS__)) s f(43, t)
+#define REFL_DOARG45(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG44(s, f, __VA_ARGS__)) s f(44, t)
+#define REFL_DOARG46(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG45(s, f, __VA_ARGS__)) s f(45, t)
+#define REFL_DOARG47(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG46(s, f, __VA_ARGS__)) s f(46, t)
+#define REFL_DOARG48(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG47(s, f, __VA_ARGS__)) s f(47, t)
+#define REFL_DOARG49(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG48(s, f, __VA_ARGS__)) s f(48, t)
+#define REFL_DOARG50(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG49(s, f, __VA_ARGS__)) s f(49, t)
+#define REFL_DOARG51(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG50(s, f, __VA_ARGS__)) s f(50, t)
+#define REFL_DOARG52(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG51(s, f, __VA_ARGS__)) s f(51, t)
+#define REFL_DOARG53(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG52(s, f, __VA_ARGS__)) s f(52, t)
+#define REFL_DOARG54(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG53(s, f, __VA_ARGS__)) s f(53, t)
+#define REFL_DOARG55(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG54(s, f, __VA_ARGS__)) s f(54, t)
+#define REFL_DOARG56(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG55(s, f, __VA_ARGS__)) s f(55, t)
+#define REFL_DOARG57(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG56(s, f, __VA_ARGS__)) s f(56, t)
+#define REFL_DOARG58(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG57(s, f, __VA_ARGS__)) s f(57, t)
+#define REFL_DOARG59(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG58(s, f, __VA_ARGS__)) s f(58, t)
+#define REFL_DOARG60(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG59(s, f, __VA_ARGS__)) s f(59, t)
+#define REFL_DOARG61(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG60(s, f, __VA_ARGS__)) s f(60, t)
+#define REFL_DOARG62(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG61(s, f, __VA_ARGS__)) s f(61, t)
+#define REFL_DOARG63(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG62(s, f, __VA_ARGS__)) s f(62, t)
+#define REFL_DOARG64(s, f, t, ...)  REFL_MARCO_EXPAND(REFL_DOARG63(s, f, __VA_ARGS__)) s f(63, t)
 
 #define REFL_MAKE_ARGS0(_Ty)
 #define REFL_MAKE_ARGS1(_Ty)  _Ty
@@ -555,6 +752,54 @@ void Foreach(_Ty &&Object, _Func &&Func)
 #define REFL_MAKE_ARGS14(_Ty) REFL_MAKE_ARGS13(_Ty), _Ty
 #define REFL_MAKE_ARGS15(_Ty) REFL_MAKE_ARGS14(_Ty), _Ty
 #define REFL_MAKE_ARGS16(_Ty) REFL_MAKE_ARGS15(_Ty), _Ty
+#define REFL_MAKE_ARGS17(_Ty) REFL_MAKE_ARGS16(_Ty), _Ty
+#define REFL_MAKE_ARGS18(_Ty) REFL_MAKE_ARGS17(_Ty), _Ty
+#define REFL_MAKE_ARGS19(_Ty) REFL_MAKE_ARGS18(_Ty), _Ty
+#define REFL_MAKE_ARGS20(_Ty) REFL_MAKE_ARGS19(_Ty), _Ty
+#define REFL_MAKE_ARGS21(_Ty) REFL_MAKE_ARGS20(_Ty), _Ty
+#define REFL_MAKE_ARGS22(_Ty) REFL_MAKE_ARGS21(_Ty), _Ty
+#define REFL_MAKE_ARGS23(_Ty) REFL_MAKE_ARGS22(_Ty), _Ty
+#define REFL_MAKE_ARGS24(_Ty) REFL_MAKE_ARGS23(_Ty), _Ty
+#define REFL_MAKE_ARGS25(_Ty) REFL_MAKE_ARGS24(_Ty), _Ty
+#define REFL_MAKE_ARGS26(_Ty) REFL_MAKE_ARGS25(_Ty), _Ty
+#define REFL_MAKE_ARGS27(_Ty) REFL_MAKE_ARGS26(_Ty), _Ty
+#define REFL_MAKE_ARGS28(_Ty) REFL_MAKE_ARGS27(_Ty), _Ty
+#define REFL_MAKE_ARGS29(_Ty) REFL_MAKE_ARGS28(_Ty), _Ty
+#define REFL_MAKE_ARGS30(_Ty) REFL_MAKE_ARGS29(_Ty), _Ty
+#define REFL_MAKE_ARGS31(_Ty) REFL_MAKE_ARGS30(_Ty), _Ty
+#define REFL_MAKE_ARGS32(_Ty) REFL_MAKE_ARGS31(_Ty), _Ty
+#define REFL_MAKE_ARGS33(_Ty) REFL_MAKE_ARGS32(_Ty), _Ty
+#define REFL_MAKE_ARGS34(_Ty) REFL_MAKE_ARGS33(_Ty), _Ty
+#define REFL_MAKE_ARGS35(_Ty) REFL_MAKE_ARGS34(_Ty), _Ty
+#define REFL_MAKE_ARGS36(_Ty) REFL_MAKE_ARGS35(_Ty), _Ty
+#define REFL_MAKE_ARGS37(_Ty) REFL_MAKE_ARGS36(_Ty), _Ty
+#define REFL_MAKE_ARGS38(_Ty) REFL_MAKE_ARGS37(_Ty), _Ty
+#define REFL_MAKE_ARGS39(_Ty) REFL_MAKE_ARGS38(_Ty), _Ty
+#define REFL_MAKE_ARGS40(_Ty) REFL_MAKE_ARGS39(_Ty), _Ty
+#define REFL_MAKE_ARGS41(_Ty) REFL_MAKE_ARGS40(_Ty), _Ty
+#define REFL_MAKE_ARGS42(_Ty) REFL_MAKE_ARGS41(_Ty), _Ty
+#define REFL_MAKE_ARGS43(_Ty) REFL_MAKE_ARGS42(_Ty), _Ty
+#define REFL_MAKE_ARGS44(_Ty) REFL_MAKE_ARGS43(_Ty), _Ty
+#define REFL_MAKE_ARGS45(_Ty) REFL_MAKE_ARGS44(_Ty), _Ty
+#define REFL_MAKE_ARGS46(_Ty) REFL_MAKE_ARGS45(_Ty), _Ty
+#define REFL_MAKE_ARGS47(_Ty) REFL_MAKE_ARGS46(_Ty), _Ty
+#define REFL_MAKE_ARGS48(_Ty) REFL_MAKE_ARGS47(_Ty), _Ty
+#define REFL_MAKE_ARGS49(_Ty) REFL_MAKE_ARGS48(_Ty), _Ty
+#define REFL_MAKE_ARGS50(_Ty) REFL_MAKE_ARGS49(_Ty), _Ty
+#define REFL_MAKE_ARGS51(_Ty) REFL_MAKE_ARGS50(_Ty), _Ty
+#define REFL_MAKE_ARGS52(_Ty) REFL_MAKE_ARGS51(_Ty), _Ty
+#define REFL_MAKE_ARGS53(_Ty) REFL_MAKE_ARGS52(_Ty), _Ty
+#define REFL_MAKE_ARGS54(_Ty) REFL_MAKE_ARGS53(_Ty), _Ty
+#define REFL_MAKE_ARGS55(_Ty) REFL_MAKE_ARGS54(_Ty), _Ty
+#define REFL_MAKE_ARGS56(_Ty) REFL_MAKE_ARGS55(_Ty), _Ty
+#define REFL_MAKE_ARGS57(_Ty) REFL_MAKE_ARGS56(_Ty), _Ty
+#define REFL_MAKE_ARGS58(_Ty) REFL_MAKE_ARGS57(_Ty), _Ty
+#define REFL_MAKE_ARGS59(_Ty) REFL_MAKE_ARGS58(_Ty), _Ty
+#define REFL_MAKE_ARGS60(_Ty) REFL_MAKE_ARGS59(_Ty), _Ty
+#define REFL_MAKE_ARGS61(_Ty) REFL_MAKE_ARGS60(_Ty), _Ty
+#define REFL_MAKE_ARGS62(_Ty) REFL_MAKE_ARGS61(_Ty), _Ty
+#define REFL_MAKE_ARGS63(_Ty) REFL_MAKE_ARGS62(_Ty), _Ty
+#define REFL_MAKE_ARGS64(_Ty) REFL_MAKE_ARGS63(_Ty), _Ty
 
 #define REFL_MAKE_ARGS(_Ty, Count) REFL_CONCAT(REFL_MAKE_ARGS, Count)(_Ty)
 
@@ -562,6 +807,82 @@ void Foreach(_Ty &&Object, _Func &&Func)
     REFL_MARCO_EXPAND(REFL_CONCAT(REFL_DOARG, REFL_ARG_COUNT(__VA_ARGS__))(sepatator, fun, __VA_ARGS__))
 #define REFL_EXPAND_EACH(sepatator, fun, ...) REFL_EXPAND_EACH_(sepatator, fun, __VA_ARGS__)
 
+//
+// f(t) for each argument in order, comma separated
+//
+
+#define REFL_FORWARD0(f, ...)
+#define REFL_FORWARD1(f, t)       f(t)
+#define REFL_FORWARD2(f, t, ...)   f(t), REFL_MARCO_EXPAND(REFL_FORWARD1(f, __VA_ARGS__))
+#define REFL_FORWARD3(f, t, ...)   f(t), REFL_MARCO_EXPAND(REFL_FORWARD2(f, __VA_ARGS__))
+#define REFL_FORWARD4(f, t, ...)   f(t), REFL_MARCO_EXPAND(REFL_FORWARD3(f, __VA_ARGS__))
+#define REFL_FORWARD5(f, t, ...)   f(t), REFL_MARCO_EXPAND(REFL_FORWARD4(f, __VA_ARGS__))
+#define REFL_FORWARD6(f, t, ...)   f(t), REFL_MARCO_EXPAND(REFL_FORWARD5(f, __VA_ARGS__))
+#define REFL_FORWARD7(f, t, ...)   f(t), REFL_MARCO_EXPAND(REFL_FORWARD6(f, __VA_ARGS__))
+#define REFL_FORWARD8(f, t, ...)   f(t), REFL_MARCO_EXPAND(REFL_FORWARD7(f, __VA_ARGS__))
+#define REFL_FORWARD9(f, t, ...)   f(t), REFL_MARCO_EXPAND(REFL_FORWARD8(f, __VA_ARGS__))
+#define REFL_FORWARD10(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD9(f, __VA_ARGS__))
+#define REFL_FORWARD11(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD10(f, __VA_ARGS__))
+#define REFL_FORWARD12(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD11(f, __VA_ARGS__))
+#define REFL_FORWARD13(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD12(f, __VA_ARGS__))
+#define REFL_FORWARD14(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD13(f, __VA_ARGS__))
+#define REFL_FORWARD15(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD14(f, __VA_ARGS__))
+#define REFL_FORWARD16(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD15(f, __VA_ARGS__))
+#define REFL_FORWARD17(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD16(f, __VA_ARGS__))
+#define REFL_FORWARD18(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD17(f, __VA_ARGS__))
+#define REFL_FORWARD19(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD18(f, __VA_ARGS__))
+#define REFL_FORWARD20(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD19(f, __VA_ARGS__))
+#define REFL_FORWARD21(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD20(f, __VA_ARGS__))
+#define REFL_FORWARD22(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD21(f, __VA_ARGS__))
+#define REFL_FORWARD23(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD22(f, __VA_ARGS__))
+#define REFL_FORWARD24(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD23(f, __VA_ARGS__))
+#define REFL_FORWARD25(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD24(f, __VA_ARGS__))
+#define REFL_FORWARD26(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD25(f, __VA_ARGS__))
+#define REFL_FORWARD27(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD26(f, __VA_ARGS__))
+#define REFL_FORWARD28(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD27(f, __VA_ARGS__))
+#define REFL_FORWARD29(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD28(f, __VA_ARGS__))
+#define REFL_FORWARD30(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD29(f, __VA_ARGS__))
+#define REFL_FORWARD31(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD30(f, __VA_ARGS__))
+#define REFL_FORWARD32(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD31(f, __VA_ARGS__))
+#define REFL_FORWARD33(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD32(f, __VA_ARGS__))
+#define REFL_FORWARD34(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD33(f, __VA_ARGS__))
+#define REFL_FORWARD35(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD34(f, __VA_ARGS__))
+#define REFL_FORWARD36(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD35(f, __VA_ARGS__))
+#define REFL_FORWARD37(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD36(f, __VA_ARGS__))
+#define REFL_FORWARD38(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD37(f, __VA_ARGS__))
+#define REFL_FORWARD39(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD38(f, __VA_ARGS__))
+#define REFL_FORWARD40(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD39(f, __VA_ARGS__))
+#define REFL_FORWARD41(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD40(f, __VA_ARGS__))
+#define REFL_FORWARD42(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD41(f, __VA_ARGS__))
+#define REFL_FORWARD43(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD42(f, __VA_ARGS__))
+#define REFL_FORWARD44(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD43(f, __VA_ARGS__))
+#define REFL_FORWARD45(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD44(f, __VA_ARGS__))
+#define REFL_FORWARD46(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD45(f, __VA_ARGS__))
+#define REFL_FORWARD47(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD46(f, __VA_ARGS__))
+#define REFL_FORWARD48(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD47(f, __VA_ARGS__))
+#define REFL_FORWARD49(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD48(f, __VA_ARGS__))
+#define REFL_FORWARD50(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD49(f, __VA_ARGS__))
+#define REFL_FORWARD51(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD50(f, __VA_ARGS__))
+#define REFL_FORWARD52(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD51(f, __VA_ARGS__))
+#define REFL_FORWARD53(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD52(f, __VA_ARGS__))
+#define REFL_FORWARD54(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD53(f, __VA_ARGS__))
+#define REFL_FORWARD55(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD54(f, __VA_ARGS__))
+#define REFL_FORWARD56(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD55(f, __VA_ARGS__))
+#define REFL_FORWARD57(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD56(f, __VA_ARGS__))
+#define REFL_FORWARD58(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD57(f, __VA_ARGS__))
+#define REFL_FORWARD59(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD58(f, __VA_ARGS__))
+#define REFL_FORWARD60(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD59(f, __VA_ARGS__))
+#define REFL_FORWARD61(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD60(f, __VA_ARGS__))
+#define REFL_FORWARD62(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD61(f, __VA_ARGS__))
+#define REFL_FORWARD63(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD62(f, __VA_ARGS__))
+#define REFL_FORWARD64(f, t, ...)  f(t), REFL_MARCO_EXPAND(REFL_FORWARD63(f, __VA_ARGS__))
+
+#define REFL_FORWARD_EACH_(fun, ...)                                                                                   \
+    REFL_MARCO_EXPAND(REFL_CONCAT(REFL_FORWARD, REFL_ARG_COUNT(__VA_ARGS__))(fun, __VA_ARGS__))
+#define REFL_FORWARD_EACH(fun, ...) REFL_FORWARD_EACH_(fun, __VA_ARGS__)
+
+#define REFL_MEMBER_OF(X) Object.X
+
 #define REFL_RETURN_NAME(_Idx, X)                                                                                      \
     if constexpr ((_Idx) == _I) {                                                                                      \
         return #X;                                                                                                     \
@@ -601,6 +922,11 @@ public:
         {                                                                                                              \
             return REFL_ARG_COUNT(__VA_ARGS__);                                                                        \
         }                                                                                                              \
+        template <typename _Object, typename _Visitor>                                                                 \
+        static constexpr decltype(auto) VISIT(_Object &Object, _Visitor &&Visitor)                                     \
+        {                                                                                                              \
+            return Visitor(REFL_FORWARD_EACH(REFL_MEMBER_OF, __VA_ARGS__));                                            \
+        }                                                                                                              \
         template <std::size_t _I>                                                                                      \
         static constexpr auto &GET_NAME()                                                                              \
         {                                                                                                              \
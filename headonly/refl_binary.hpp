@@ -0,0 +1,353 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "refl.hpp"
+
+namespace REFL
+{
+namespace DETAIL
+{
+
+//
+// length prefix of strings and containers
+//
+
+using BinaryLength = uint32_t;
+
+//
+// container traits
+//
+
+template <typename _Ty>
+using ElementType = RemoveCVRType<decltype(*std::begin(std::declval<_Ty &>()))>;
+
+inline BinaryLength CheckedLength(size_t Length)
+{
+    if (Length > BinaryLength(-1)) {
+        throw std::length_error("binary length prefix overflow");
+    }
+
+    return BinaryLength(Length);
+}
+
+//
+// encoded size
+//
+
+template <typename _Ty>
+size_t BinarySizeImpl(const _Ty &Object)
+{
+    if constexpr (IsPaddingFree<_Ty>) {
+        return sizeof(_Ty);
+    }
+    else if constexpr (IsStringType<_Ty>) {
+        return sizeof(BinaryLength) + CheckedLength(Object.length()) * sizeof(typename _Ty::value_type);
+    }
+    else if constexpr (IsMapType<_Ty>) {
+        size_t Size = sizeof(BinaryLength);
+        for (auto &&[Key, Value] : Object) {
+            Size += BinarySizeImpl(Key) + BinarySizeImpl(Value);
+        }
+        return Size;
+    }
+    else if constexpr (IsContainerType<_Ty>) {
+        using Element = ElementType<_Ty>;
+
+        const size_t Count = CheckedLength(std::size(Object));
+
+        if constexpr (IsPaddingFree<Element>) {
+            return sizeof(BinaryLength) + Count * sizeof(Element);
+        }
+        else {
+            size_t Size = sizeof(BinaryLength);
+            for (auto &&Item : Object) {
+                Size += BinarySizeImpl(Item);
+            }
+            return Size;
+        }
+    }
+    else if constexpr (std::is_array_v<_Ty>) {
+        size_t Size = 0;
+        for (auto &&Item : Object) {
+            Size += BinarySizeImpl(Item);
+        }
+        return Size;
+    }
+    else if constexpr (std::is_class_v<_Ty>) {
+        size_t Size = 0;
+        Foreach(Object, [&](auto &&Member) { Size += BinarySizeImpl(Member); });
+        return Size;
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be serialized");
+    }
+}
+
+//
+// writer, the buffer is sized up front: no checks, no allocation
+//
+
+inline void WriteRaw(char *&Cursor, const void *Data, size_t Size)
+{
+    std::memcpy(Cursor, Data, Size);
+    Cursor += Size;
+}
+
+template <typename _Ty>
+void BinaryWriteImpl(const _Ty &Object, char *&Cursor)
+{
+    if constexpr (IsPaddingFree<_Ty>) {
+        WriteRaw(Cursor, &Object, sizeof(_Ty));
+    }
+    else if constexpr (IsStringType<_Ty>) {
+        const BinaryLength Length = BinaryLength(Object.length());
+        WriteRaw(Cursor, &Length, sizeof(Length));
+        WriteRaw(Cursor, Object.data(), Length * sizeof(typename _Ty::value_type));
+    }
+    else if constexpr (IsMapType<_Ty>) {
+        const BinaryLength Count = BinaryLength(std::size(Object));
+        WriteRaw(Cursor, &Count, sizeof(Count));
+        for (auto &&[Key, Value] : Object) {
+            BinaryWriteImpl(Key, Cursor);
+            BinaryWriteImpl(Value, Cursor);
+        }
+    }
+    else if constexpr (IsContainerType<_Ty>) {
+        using Element = ElementType<_Ty>;
+
+        const BinaryLength Count = BinaryLength(std::size(Object));
+        WriteRaw(Cursor, &Count, sizeof(Count));
+
+        if constexpr (IsPaddingFree<Element> && IsContiguousImpl<_Ty>::value) {
+            WriteRaw(Cursor, std::data(Object), Count * sizeof(Element));
+        }
+        else {
+            for (auto &&Item : Object) {
+                BinaryWriteImpl(Item, Cursor);
+            }
+        }
+    }
+    else if constexpr (std::is_array_v<_Ty>) {
+        for (auto &&Item : Object) {
+            BinaryWriteImpl(Item, Cursor);
+        }
+    }
+    else if constexpr (std::is_class_v<_Ty>) {
+        Foreach(Object, [&](auto &&Member) { BinaryWriteImpl(Member, Cursor); });
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be serialized");
+    }
+}
+
+//
+// reader, bounds checked
+//
+
+struct BinaryReader {
+    const char *Cursor;
+    const char *End;
+
+    void Raw(void *Data, size_t Size)
+    {
+        Require(Size);
+        std::memcpy(Data, Cursor, Size);
+        Cursor += Size;
+    }
+
+    size_t Remaining() const { return size_t(End - Cursor); }
+
+    void Require(size_t Size) const
+    {
+        if (Remaining() < Size) {
+            throw std::out_of_range("binary input truncated");
+        }
+    }
+
+    BinaryLength Length()
+    {
+        BinaryLength Length;
+        Raw(&Length, sizeof(Length));
+        return Length;
+    }
+};
+
+//
+// fewest bytes an item can be encoded in, bounds an untrusted count before anything is allocated
+//
+
+template <typename _Ty>
+constexpr size_t MinBinarySize();
+
+struct MinBinarySizeVisitor {
+    template <typename... _Args>
+    constexpr auto operator()(_Args &&...) const
+    {
+        return std::integral_constant<size_t, (size_t(0) + ... + MinBinarySize<RemoveCVRType<_Args>>())>{};
+    }
+};
+
+template <typename _Ty>
+constexpr size_t MinBinarySize()
+{
+    if constexpr (IsPaddingFree<_Ty>) {
+        return sizeof(_Ty);
+    }
+    else if constexpr (IsStringType<_Ty> || IsContainerType<_Ty>) {
+        return sizeof(BinaryLength);
+    }
+    else if constexpr (std::is_array_v<_Ty>) {
+        return std::extent_v<_Ty> * MinBinarySize<std::remove_extent_t<_Ty>>();
+    }
+    else if constexpr (IsVisitable<_Ty>) {
+        return decltype(Visits(std::declval<_Ty &>(), MinBinarySizeVisitor{}))::value;
+    }
+
+    return 0;
+}
+
+// items that encode to no bytes can not be bounded by the input, their count is capped instead
+constexpr BinaryLength BinaryMaxEmptyItems = BinaryLength(1) << 20;
+
+// the count is untrusted: the rest of the input must be able to hold that many items of MinSize bytes
+inline void RequireCount(const BinaryReader &Reader, BinaryLength Count, size_t MinSize)
+{
+    if (MinSize != 0 ? Count > Reader.Remaining() / MinSize : Count > BinaryMaxEmptyItems) {
+        throw std::out_of_range("binary input truncated");
+    }
+}
+
+template <typename _Ty>
+void BinaryReadImpl(_Ty &Object, BinaryReader &Reader)
+{
+    if constexpr (IsPaddingFree<_Ty>) {
+        Reader.Raw(&Object, sizeof(_Ty));
+    }
+    else if constexpr (IsStringType<_Ty>) {
+        const BinaryLength Length = Reader.Length();
+        Reader.Require(Length * sizeof(typename _Ty::value_type));
+        Object.resize(Length);
+        Reader.Raw(Object.data(), Length * sizeof(typename _Ty::value_type));
+    }
+    else if constexpr (IsMapType<_Ty>) {
+        using Key   = typename _Ty::key_type;
+        using Value = typename _Ty::mapped_type;
+
+        BinaryLength Count = Reader.Length();
+        RequireCount(Reader, Count, MinBinarySize<Key>() + MinBinarySize<Value>());
+
+        Object.clear();
+        for (; Count != 0; Count--) {
+            Key   First{};
+            Value Second{};
+            BinaryReadImpl(First, Reader);
+            BinaryReadImpl(Second, Reader);
+            Object.emplace(std::move(First), std::move(Second));
+        }
+    }
+    else if constexpr (IsContainerType<_Ty>) {
+        using Element = ElementType<_Ty>;
+
+        const BinaryLength Count = Reader.Length();
+
+        if constexpr (IsPaddingFree<Element> && IsContiguousImpl<_Ty>::value && IsResizableImpl<_Ty>::value) {
+            Reader.Require(Count * sizeof(Element));
+            Object.resize(Count);
+            Reader.Raw(std::data(Object), Count * sizeof(Element));
+        }
+        else if constexpr (IsTupleLike<_Ty>) {
+            // std::array: read in place, the count is part of the type
+            if (Count != std::size(Object)) {
+                throw std::out_of_range("binary array length mismatch");
+            }
+            for (auto &&Item : Object) {
+                BinaryReadImpl(Item, Reader);
+            }
+        }
+        else if constexpr (IsResizableImpl<_Ty>::value) {
+            RequireCount(Reader, Count, MinBinarySize<Element>());
+            Object.resize(Count);
+            for (auto &&Item : Object) {
+                BinaryReadImpl(Item, Reader);
+            }
+        }
+        else {
+            // no resize: grow as items arrive
+            RequireCount(Reader, Count, MinBinarySize<Element>());
+            Object.clear();
+            for (BinaryLength Index = 0; Index != Count; Index++) {
+                Element Item{};
+                BinaryReadImpl(Item, Reader);
+                Object.insert(Object.end(), std::move(Item));
+            }
+        }
+    }
+    else if constexpr (std::is_array_v<_Ty>) {
+        for (auto &&Item : Object) {
+            BinaryReadImpl(Item, Reader);
+        }
+    }
+    else if constexpr (std::is_class_v<_Ty>) {
+        Foreach(Object, [&](auto &&Member) { BinaryReadImpl(Member, Reader); });
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be deserialized");
+    }
+}
+
+} // namespace DETAIL
+
+//
+// binary serialization, host byte order.
+//  padding free           -> raw bytes
+//  string, container, map -> uint32 count + items
+//  class                  -> members in visit order
+//
+
+template <typename _Ty>
+size_t BinarySize(const _Ty &Object)
+{
+    return DETAIL::BinarySizeImpl(Object);
+}
+
+// Buffer must hold BinarySize(Object) bytes, returns the bytes written
+template <typename _Ty>
+size_t BinaryWrite(const _Ty &Object, void *Buffer)
+{
+    char *Cursor = static_cast<char *>(Buffer);
+    DETAIL::BinaryWriteImpl(Object, Cursor);
+    return size_t(Cursor - static_cast<char *>(Buffer));
+}
+
+// returns the bytes consumed, throws std::out_of_range on truncated input
+template <typename _Ty>
+size_t BinaryRead(_Ty &Object, const void *Buffer, size_t Size)
+{
+    DETAIL::BinaryReader Reader{static_cast<const char *>(Buffer), static_cast<const char *>(Buffer) + Size};
+    DETAIL::BinaryReadImpl(Object, Reader);
+    return size_t(Reader.Cursor - static_cast<const char *>(Buffer));
+}
+
+//
+// whole buffer helpers, _Buffer is std::string / std::vector<char>
+//
+
+template <typename _Ty, typename _Buffer>
+void Serialize(const _Ty &Object, _Buffer &Buffer)
+{
+    Buffer.resize(BinarySize(Object));
+    BinaryWrite(Object, Buffer.data());
+}
+
+template <typename _Ty, typename _Buffer>
+void Deserialize(_Ty &Object, const _Buffer &Buffer)
+{
+    BinaryRead(Object, Buffer.data(), Buffer.size());
+}
+
+} // namespace REFL
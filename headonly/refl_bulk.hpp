@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "refl_binary.hpp"
+
+namespace REFL
+{
+namespace DETAIL
+{
+
+//
+// Body(Thread, Begin, End) on Threads contiguous blocks of [0, Count), the caller runs block 0.
+// the first exception is rethrown after all blocks finished.
+//
+
+template <typename _Body>
+void ParallelBlocks(size_t Count, size_t Threads, _Body &&Body)
+{
+    Threads = std::max<size_t>(1, std::min(Threads, Count));
+
+    const size_t Chunk = (Count + Threads - 1) / Threads;
+
+    std::vector<std::exception_ptr> Errors(Threads);
+    auto                            Block = [&](size_t Thread) {
+        try {
+            Body(Thread, std::min(Thread * Chunk, Count), std::min(Thread * Chunk + Chunk, Count));
+        }
+        catch (...) {
+            Errors[Thread] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> Workers;
+    for (size_t Thread = 1; Thread < Threads; Thread++) {
+        Workers.emplace_back(Block, Thread);
+    }
+    Block(0);
+
+    for (auto &Worker : Workers) {
+        Worker.join();
+    }
+    for (auto &Error : Errors) {
+        if (Error) {
+            std::rethrow_exception(Error);
+        }
+    }
+}
+
+//
+// layout: uint64 count, uint64 offsets [count + 1] relative to the first record, records back to back
+//
+
+constexpr size_t BulkIndexSize(size_t Count)
+{
+    return (Count + 2) * sizeof(uint64_t);
+}
+
+} // namespace DETAIL
+
+//
+// bulk serialization of record vectors on Threads threads, records in the binary format.
+//  encode: sizes and a block-wise prefix sum give every record its offset, then each thread
+//          writes its records straight into the one output buffer.
+//  decode: the stored offset index lets every thread start at its first record.
+//
+
+template <typename _Ty, typename _Buffer>
+void BulkSerialize(const std::vector<_Ty> &Records, _Buffer &Buffer, size_t Threads)
+{
+    const size_t          Count = Records.size();
+    std::vector<uint64_t> Offsets(Count + 1);
+
+    // phase 1: sizes and block local prefix sums
+    Threads = std::max<size_t>(1, std::min(Threads, Count));
+
+    std::vector<uint64_t> Totals(Threads);
+    DETAIL::ParallelBlocks(Count, Threads, [&](size_t Thread, size_t Begin, size_t End) {
+        uint64_t Total = 0;
+        for (size_t Index = Begin; Index != End; Index++) {
+            Total += DETAIL::BinarySizeImpl(Records[Index]);
+            Offsets[Index + 1] = Total;
+        }
+        Totals[Thread] = Total;
+    });
+
+    uint64_t Base = 0;
+    for (auto &Total : Totals) {
+        Base += std::exchange(Total, Base);
+    }
+
+    const size_t Header = DETAIL::BulkIndexSize(Count);
+    Buffer.resize(Header + Base);
+
+    char *const    Output = reinterpret_cast<char *>(Buffer.data());
+    const uint64_t Fixed[2] = {Count, 0};
+    std::memcpy(Output, Fixed, sizeof(Fixed));
+
+    // phase 2: block bases, index and records
+    DETAIL::ParallelBlocks(Count, Threads, [&](size_t Thread, size_t Begin, size_t End) {
+        char *Cursor = Output + Header + Totals[Thread];
+        for (size_t Index = Begin; Index != End; Index++) {
+            const uint64_t Next = Offsets[Index + 1] + Totals[Thread];
+            std::memcpy(Output + (Index + 2) * sizeof(uint64_t), &Next, sizeof(Next));
+            DETAIL::BinaryWriteImpl(Records[Index], Cursor);
+        }
+    });
+}
+
+// throws std::out_of_range on a truncated buffer or a record that does not fill its slot
+template <typename _Ty>
+void BulkDeserialize(std::vector<_Ty> &Records, const void *Buffer, size_t Size, size_t Threads)
+{
+    const char *Input = static_cast<const char *>(Buffer);
+
+    uint64_t Count;
+    if (Size < sizeof(Count)) {
+        throw std::out_of_range("bulk input truncated");
+    }
+    std::memcpy(&Count, Input, sizeof(Count));
+    if (Count > Size / sizeof(uint64_t) || DETAIL::BulkIndexSize(size_t(Count)) > Size) {
+        throw std::out_of_range("bulk input truncated");
+    }
+
+    const size_t Header = DETAIL::BulkIndexSize(size_t(Count));
+    const char  *Data   = Input + Header;
+    const size_t Bytes  = Size - Header;
+
+    auto Offset = [&](size_t Index) {
+        uint64_t Value;
+        std::memcpy(&Value, Input + (Index + 1) * sizeof(uint64_t), sizeof(Value));
+        return Value;
+    };
+
+    Records.resize(size_t(Count));
+    DETAIL::ParallelBlocks(size_t(Count), Threads, [&](size_t, size_t Begin, size_t End) {
+        uint64_t Current = Offset(Begin);
+        for (size_t Index = Begin; Index != End; Index++) {
+            const uint64_t Next = Offset(Index + 1);
+            if (Next < Current || Next > Bytes) {
+                throw std::out_of_range("bulk offset index corrupt");
+            }
+
+            DETAIL::BinaryReader Reader{Data + Current, Data + Next};
+            DETAIL::BinaryReadImpl(Records[Index], Reader);
+            if (Reader.Cursor != Reader.End) {
+                throw std::out_of_range("bulk record size mismatch");
+            }
+            Current = Next;
+        }
+    });
+}
+
+template <typename _Ty, typename _Buffer>
+void BulkDeserialize(std::vector<_Ty> &Records, const _Buffer &Buffer, size_t Threads)
+{
+    BulkDeserialize(Records, Buffer.data(), Buffer.size(), Threads);
+}
+
+} // namespace REFL
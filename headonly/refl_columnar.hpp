@@ -0,0 +1,526 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "refl_field.hpp"
+#include "refl_soa.hpp"
+
+namespace REFL
+{
+
+//
+// malformed file, or a file written for another schema
+//
+
+struct ColumnarError : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+namespace DETAIL
+{
+
+//
+// file layout, host byte order:
+//  header     magic, schema fingerprint, rows, columns
+//  directory  per member: offset and size of the column, offset and size of the string blob
+//  columns    each at a SoaAlignment boundary. padding free members are raw arrays,
+//             strings are uint64 offsets [rows + 1] into a blob of characters
+//
+
+constexpr uint64_t ColumnarMagic = 0x314c4f434c464552ull; // "REFLCOL1"
+
+struct ColumnarHeader {
+    uint64_t Magic;
+    uint64_t Fingerprint;
+    uint64_t Rows;
+    uint64_t Columns;
+};
+
+struct ColumnarEntry {
+    uint64_t Offset;
+    uint64_t Size;
+    uint64_t BlobOffset;
+    uint64_t BlobSize;
+};
+
+// one string cell, the offsets come from the file: checked against the blob on every access
+template <typename _Char>
+std::basic_string_view<_Char> StringCell(const uint64_t *Offsets, const _Char *Blob, uint64_t Length, size_t Row)
+{
+    const uint64_t Begin = Offsets[Row];
+    const uint64_t End   = Offsets[Row + 1];
+
+    if (Begin > End || End > Length) {
+        throw ColumnarError("columnar string offsets corrupt");
+    }
+    return {Blob + Begin, size_t(End - Begin)};
+}
+
+constexpr uint64_t AlignColumn(uint64_t Offset)
+{
+    return (Offset + SoaAlignment - 1) & ~uint64_t(SoaAlignment - 1);
+}
+
+template <typename _Ty>
+constexpr bool IsColumnType = IsPaddingFree<_Ty> || IsStringType<_Ty>;
+
+//
+// schema fingerprint: FNV-1a over member count, names, TYPE_ID and sizes, nested classes included
+//
+
+constexpr uint64_t FingerprintAdd(uint64_t Hash, std::string_view Bytes)
+{
+    for (char Char : Bytes) {
+        Hash ^= uint8_t(Char);
+        Hash *= 0x100000001b3ull;
+    }
+    return Hash;
+}
+
+constexpr uint64_t FingerprintAdd(uint64_t Hash, uint64_t Value)
+{
+    for (size_t Byte = 0; Byte != sizeof(Value); Byte++) {
+        Hash ^= uint8_t(Value >> (8 * Byte));
+        Hash *= 0x100000001b3ull;
+    }
+    return Hash;
+}
+
+template <typename _Ty, typename... _Args>
+constexpr uint64_t FingerprintImpl(TypeList<_Args...>);
+
+template <typename _Ty>
+constexpr uint64_t FingerprintMember(uint64_t Hash)
+{
+    Hash = FingerprintAdd(FingerprintAdd(Hash, uint64_t(GetTypeId<_Ty>())), sizeof(_Ty));
+
+    if constexpr (std::is_array_v<_Ty>) {
+        Hash = FingerprintMember<std::remove_all_extents_t<_Ty>>(Hash);
+    }
+    else if constexpr (std::is_class_v<_Ty> && !IsStringType<_Ty> && !IsContainerType<_Ty>) {
+        Hash = FingerprintAdd(Hash, FingerprintImpl<_Ty>(MemberTypes<_Ty>{}));
+    }
+    return Hash;
+}
+
+template <typename _Ty, typename... _Args>
+constexpr uint64_t FingerprintImpl(TypeList<_Args...>)
+{
+    constexpr auto Names = MakeNames<_Ty>(std::index_sequence_for<_Args...>{});
+
+    uint64_t Hash  = FingerprintAdd(0xcbf29ce484222325ull, uint64_t(sizeof...(_Args)));
+    size_t   Index = 0;
+    ((Hash = FingerprintMember<_Args>(FingerprintAdd(Hash, Names[Index++]))), ...);
+    return Hash;
+}
+
+//
+// one column while writing
+//
+
+struct ColumnCursor {
+    char     *Data      = nullptr;
+    uint64_t *Offsets   = nullptr;
+    char     *Blob      = nullptr;
+    uint64_t  Character = 0;
+};
+
+template <typename _Ty>
+uint64_t CellBlobSize(const _Ty &Member)
+{
+    if constexpr (IsStringType<_Ty>) {
+        return Member.length() * sizeof(typename _Ty::value_type);
+    }
+    else {
+        return 0;
+    }
+}
+
+template <typename _Ty>
+void WriteCell(const _Ty &Member, ColumnCursor &Cursor)
+{
+    if constexpr (IsStringType<_Ty>) {
+        const size_t Bytes = Member.length() * sizeof(typename _Ty::value_type);
+        std::memcpy(Cursor.Blob, Member.data(), Bytes);
+        Cursor.Blob += Bytes;
+        Cursor.Character += Member.length();
+        *Cursor.Offsets++ = Cursor.Character;
+    }
+    else {
+        std::memcpy(Cursor.Data, &Member, sizeof(_Ty));
+        Cursor.Data += sizeof(_Ty);
+    }
+}
+
+template <typename _Ty>
+void ReadCell(const char *Base, const ColumnarEntry &Entry, size_t Row, _Ty &Member)
+{
+    if constexpr (IsStringType<_Ty>) {
+        using Char = typename _Ty::value_type;
+
+        const auto Cell = StringCell(reinterpret_cast<const uint64_t *>(Base + Entry.Offset),
+                                     reinterpret_cast<const Char *>(Base + Entry.BlobOffset),
+                                     Entry.BlobSize / sizeof(Char), Row);
+        Member.assign(Cell.data(), Cell.size());
+    }
+    else {
+        std::memcpy(&Member, Base + Entry.Offset + Row * sizeof(_Ty), sizeof(_Ty));
+    }
+}
+
+// column placement, BlobSize is filled in; returns the file size
+template <typename... _Args>
+uint64_t ColumnarLayout(TypeList<_Args...>, ColumnarEntry *Entries, size_t Rows)
+{
+    static_assert((IsColumnType<_Args> && ...), "columnar members must be padding free or strings");
+
+    uint64_t Offset = AlignColumn(sizeof(ColumnarHeader) + sizeof...(_Args) * sizeof(ColumnarEntry));
+    auto     Place  = [&](ColumnarEntry &Entry, bool String, size_t Size) {
+        Entry.Offset = Offset;
+        Entry.Size   = String ? (Rows + 1) * sizeof(uint64_t) : Rows * Size;
+        Offset       = AlignColumn(Offset + Entry.Size);
+        if (String) {
+            Entry.BlobOffset = Offset;
+            Offset           = AlignColumn(Offset + Entry.BlobSize);
+        }
+    };
+
+    size_t Index = 0;
+    (Place(Entries[Index++], IsStringType<_Args>, sizeof(_Args)), ...);
+    return Offset;
+}
+
+//
+// read only mapping of a whole file
+//
+
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string &Path)
+    {
+#if defined(_WIN32)
+        const HANDLE File = CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (File == INVALID_HANDLE_VALUE) {
+            throw ColumnarError("can not open " + Path);
+        }
+
+        LARGE_INTEGER Length{};
+        if (!GetFileSizeEx(File, &Length)) {
+            CloseHandle(File);
+            throw ColumnarError("can not stat " + Path);
+        }
+        Size_ = size_t(Length.QuadPart);
+
+        const HANDLE Mapping = Size_ != 0 ? CreateFileMappingA(File, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+        CloseHandle(File);
+        if (Mapping != nullptr) {
+            Data_ = static_cast<const char *>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(Mapping);
+        }
+#else
+        const int File = ::open(Path.c_str(), O_RDONLY);
+        if (File < 0) {
+            throw ColumnarError("can not open " + Path);
+        }
+
+        struct stat Status {};
+        if (::fstat(File, &Status) != 0) {
+            ::close(File);
+            throw ColumnarError("can not stat " + Path);
+        }
+        Size_ = size_t(Status.st_size);
+
+        if (Size_ != 0) {
+            void *Address = ::mmap(nullptr, Size_, PROT_READ, MAP_SHARED, File, 0);
+            Data_         = Address != MAP_FAILED ? static_cast<const char *>(Address) : nullptr;
+        }
+        ::close(File);
+#endif
+        if (Data_ == nullptr) {
+            throw ColumnarError("can not map " + Path);
+        }
+    }
+
+    MappedFile(MappedFile &&Other) noexcept
+        : Data_(std::exchange(Other.Data_, nullptr)), Size_(std::exchange(Other.Size_, 0))
+    {
+    }
+
+    MappedFile &operator=(MappedFile &&) = delete;
+
+    ~MappedFile()
+    {
+        if (Data_ == nullptr) {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(Data_);
+#else
+        ::munmap(const_cast<char *>(Data_), Size_);
+#endif
+    }
+
+    const char *data() const { return Data_; }
+    size_t      size() const { return Size_; }
+
+private:
+    const char *Data_ = nullptr;
+    size_t      Size_ = 0;
+};
+
+} // namespace DETAIL
+
+//
+// compile time identity of the member layout. renaming, reordering or resizing a member changes it
+//
+
+template <typename _Ty>
+constexpr uint64_t SchemaFingerprint()
+{
+    using Type = DETAIL::RemoveCVRType<_Ty>;
+    return DETAIL::FingerprintImpl<Type>(DETAIL::MemberTypes<Type>{});
+}
+
+//
+// string column: row -> view into the blob
+//
+
+template <typename _Char>
+struct StringColumn {
+    const uint64_t *Offsets = nullptr; // Size + 1 entries, in characters
+    const _Char    *Blob    = nullptr;
+    size_t          Size    = 0;
+    uint64_t        Length  = 0; // of the blob, in characters
+
+    size_t size() const { return Size; }
+
+    // throws ColumnarError for offsets outside the blob
+    std::basic_string_view<_Char> operator[](size_t Index) const
+    {
+        return DETAIL::StringCell(Offsets, Blob, Length, Index);
+    }
+};
+
+//
+// columnar image of a vector of reflected records. members must be padding free or strings.
+//  ColumnarWrite(Rows, Buffer)  _Buffer is std::string / std::vector<char>
+//  ColumnarSave(Rows, Path)
+//
+
+template <typename _Ty, typename _Buffer>
+void ColumnarWrite(const std::vector<_Ty> &Rows, _Buffer &Buffer)
+{
+    constexpr size_t Count = Counts<_Ty>();
+    static_assert(Count != 0, "columnar layout needs at least one member");
+
+    DETAIL::ColumnarEntry Entries[Count] = {};
+
+    // layout: string blobs need one pass over the rows
+    for (const _Ty &Row : Rows) {
+        Visits(Row, [&](auto &...Members) {
+            size_t Index = 0;
+            ((Entries[Index++].BlobSize += DETAIL::CellBlobSize(Members)), ...);
+        });
+    }
+
+    const uint64_t Size = DETAIL::ColumnarLayout(DETAIL::MemberTypes<_Ty>{}, Entries, Rows.size());
+
+    Buffer.assign(Size, 0);
+    char *Base = reinterpret_cast<char *>(Buffer.data());
+
+    const DETAIL::ColumnarHeader Header{DETAIL::ColumnarMagic, SchemaFingerprint<_Ty>(), Rows.size(), Count};
+    std::memcpy(Base, &Header, sizeof(Header));
+    std::memcpy(Base + sizeof(Header), Entries, sizeof(Entries));
+
+    DETAIL::ColumnCursor Cursors[Count];
+    for (size_t Index = 0; Index != Count; Index++) {
+        Cursors[Index].Data = Base + Entries[Index].Offset;
+        Cursors[Index].Blob = Base + Entries[Index].BlobOffset;
+
+        // string columns are the ones with a blob
+        if (Entries[Index].BlobOffset != 0) {
+            Cursors[Index].Offsets    = reinterpret_cast<uint64_t *>(Cursors[Index].Data);
+            *Cursors[Index].Offsets++ = 0;
+        }
+    }
+
+    for (const _Ty &Row : Rows) {
+        Visits(Row, [&](auto &...Members) {
+            size_t Index = 0;
+            (DETAIL::WriteCell(Members, Cursors[Index++]), ...);
+        });
+    }
+}
+
+template <typename _Ty>
+void ColumnarSave(const std::vector<_Ty> &Rows, const std::string &Path)
+{
+    std::string Buffer;
+    ColumnarWrite(Rows, Buffer);
+
+    std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+    if (!File.write(Buffer.data(), std::streamsize(Buffer.size()))) {
+        throw ColumnarError("can not write " + Path);
+    }
+}
+
+//
+// zero copy reader over a columnar image. the constructor checks the header, the fingerprint
+// and the column bounds; past the directory it only reads the first and last string offsets.
+// interior string offsets are checked on every access, Row() / Column<S>()[i] throw when corrupt.
+//
+
+template <typename _Ty>
+class ColumnarView
+{
+    using Traits = DETAIL::SoaTraits<DETAIL::MemberTypes<_Ty>>;
+
+public:
+    template <size_t _I>
+    using MemberType = std::tuple_element_t<_I, typename Traits::Members>;
+
+    static constexpr size_t Count = Counts<_Ty>();
+
+    ColumnarView() = default;
+
+    // Data must be aligned for every member type
+    ColumnarView(const void *Data, size_t Size) : Base(static_cast<const char *>(Data))
+    {
+        DETAIL::ColumnarHeader Header;
+        if (Size < sizeof(Header) + sizeof(Entries)) {
+            throw ColumnarError("columnar file truncated");
+        }
+        std::memcpy(&Header, Base, sizeof(Header));
+        std::memcpy(Entries, Base + sizeof(Header), sizeof(Entries));
+
+        if (Header.Magic != DETAIL::ColumnarMagic) {
+            throw ColumnarError("not a columnar file");
+        }
+        if (Header.Fingerprint != SchemaFingerprint<_Ty>() || Header.Columns != Count) {
+            throw ColumnarError("columnar file schema mismatch");
+        }
+        Rows = size_t(Header.Rows);
+
+        Validate(Size, std::make_index_sequence<Count>{});
+    }
+
+    size_t size() const { return Rows; }
+    bool   empty() const { return Rows == 0; }
+
+    // ColumnSpan<const Member>, or StringColumn<Char> for strings
+    template <size_t _I>
+    auto Column() const
+    {
+        using Member = MemberType<_I>;
+
+        if constexpr (DETAIL::IsStringType<Member>) {
+            using Char = typename Member::value_type;
+            return StringColumn<Char>{reinterpret_cast<const uint64_t *>(Base + Entries[_I].Offset),
+                                      reinterpret_cast<const Char *>(Base + Entries[_I].BlobOffset), Rows,
+                                      Entries[_I].BlobSize / sizeof(Char)};
+        }
+        else {
+            return ColumnSpan<const Member>{reinterpret_cast<const Member *>(Base + Entries[_I].Offset), Rows};
+        }
+    }
+
+    // gathers one record
+    _Ty Row(size_t Index) const
+    {
+        _Ty Object{};
+        Visits(Object, [&](auto &...Members) {
+            size_t Member = 0;
+            (DETAIL::ReadCell(Base, Entries[Member++], Index, Members), ...);
+        });
+        return Object;
+    }
+
+private:
+    template <size_t... _I>
+    void Validate(size_t Size, std::index_sequence<_I...>)
+    {
+        (ValidateColumn<_I>(Size), ...);
+    }
+
+    template <size_t _I>
+    void ValidateColumn(size_t Size)
+    {
+        using Member = MemberType<_I>;
+
+        const DETAIL::ColumnarEntry &Entry = Entries[_I];
+
+        const bool Aligned = (reinterpret_cast<uintptr_t>(Base) + Entry.Offset) % alignof(Member) == 0 &&
+                             (reinterpret_cast<uintptr_t>(Base) + Entry.Offset) % alignof(uint64_t) == 0;
+        if (!Aligned) {
+            throw ColumnarError("columnar column misaligned");
+        }
+
+        if constexpr (DETAIL::IsStringType<Member>) {
+            using Char = typename Member::value_type;
+
+            // Rows first: a corrupt count must not wrap the column size
+            if (Rows >= Size / sizeof(uint64_t) || Entry.Size != (Rows + 1) * sizeof(uint64_t) ||
+                Entry.Offset > Size || Size - Entry.Offset < Entry.Size || Entry.BlobOffset > Size ||
+                Size - Entry.BlobOffset < Entry.BlobSize) {
+                throw ColumnarError("columnar column out of bounds");
+            }
+
+            // the ends bound the blob, each cell is checked when it is read
+            const StringColumn<Char> Strings = Column<_I>();
+            if (Strings.Offsets[0] != 0 || Entry.BlobSize % sizeof(Char) != 0 ||
+                Strings.Offsets[Rows] != Strings.Length) {
+                throw ColumnarError("columnar string offsets corrupt");
+            }
+        }
+        else {
+            if (Rows > Size / sizeof(Member) || Entry.Size != Rows * sizeof(Member) || Entry.Offset > Size ||
+                Size - Entry.Offset < Entry.Size) {
+                throw ColumnarError("columnar column out of bounds");
+            }
+        }
+    }
+
+    const char           *Base = nullptr;
+    size_t                Rows = 0;
+    DETAIL::ColumnarEntry Entries[Count] = {};
+};
+
+//
+// memory mapped columnar file: opening costs the directory, pages come in on first use
+//
+
+template <typename _Ty>
+class ColumnarFile : private DETAIL::MappedFile, public ColumnarView<_Ty>
+{
+public:
+    explicit ColumnarFile(const std::string &Path)
+        : DETAIL::MappedFile(Path), ColumnarView<_Ty>(DETAIL::MappedFile::data(), DETAIL::MappedFile::size())
+    {
+    }
+
+    using ColumnarView<_Ty>::size;
+};
+
+} // namespace REFL
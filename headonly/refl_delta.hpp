@@ -0,0 +1,311 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "refl_binary.hpp"
+
+namespace REFL
+{
+
+template <typename _Ty>
+class Tracked;
+
+namespace DETAIL
+{
+
+template <typename _Ty>
+struct IsTrackedImpl : std::false_type {
+};
+
+template <typename _Ty>
+struct IsTrackedImpl<Tracked<_Ty>> : std::true_type {
+};
+
+template <typename _Ty>
+constexpr bool IsTracked = IsTrackedImpl<_Ty>::value;
+
+//
+// encoding unrolls over the members and tests their bits. with a table of function pointers
+// every dirty member is an indirect call, and random masks mispredict most of them.
+//
+
+template <typename _Ty, size_t... _I>
+size_t DeltaSizeImpl(const Tracked<_Ty> &Object, std::index_sequence<_I...>);
+
+template <typename _Ty, size_t... _I>
+void DeltaWriteImpl(const Tracked<_Ty> &Object, char *&Cursor, std::index_sequence<_I...>);
+
+template <typename _Ty>
+size_t DeltaMemberSize(const _Ty &Member)
+{
+    if constexpr (IsTracked<_Ty>) {
+        return DeltaSizeImpl(Member, std::make_index_sequence<_Ty::Count>{});
+    }
+    else {
+        return BinarySizeImpl(Member);
+    }
+}
+
+template <typename _Ty>
+void DeltaMemberWrite(const _Ty &Member, char *&Cursor)
+{
+    if constexpr (IsTracked<_Ty>) {
+        DeltaWriteImpl(Member, Cursor, std::make_index_sequence<_Ty::Count>{});
+    }
+    else {
+        BinaryWriteImpl(Member, Cursor);
+    }
+}
+
+template <size_t _I>
+void DeltaIndexWrite(char *&Cursor)
+{
+    const uint8_t Index = uint8_t(_I);
+    WriteRaw(Cursor, &Index, sizeof(Index));
+}
+
+//
+// delta of one object: uint8 count, then per dirty member uint8 index + value.
+// values are in the binary format, tracked members nest their own delta.
+//
+
+template <typename _Ty, size_t... _I>
+size_t DeltaSizeImpl(const Tracked<_Ty> &Object, std::index_sequence<_I...>)
+{
+    const uint64_t Mask = Object.DirtyMask();
+    return sizeof(uint8_t) +
+           ((Mask >> _I & 1 ? sizeof(uint8_t) + DeltaMemberSize(Object.template Get<_I>()) : 0) + ... + 0);
+}
+
+template <typename _Ty, size_t... _I>
+void DeltaWriteImpl(const Tracked<_Ty> &Object, char *&Cursor, std::index_sequence<_I...>)
+{
+    const uint64_t Mask    = Object.DirtyMask();
+    const uint8_t  Changed = uint8_t(std::bitset<64>(Mask).count());
+    WriteRaw(Cursor, &Changed, sizeof(Changed));
+
+    ((Mask >> _I & 1 ? (DeltaIndexWrite<_I>(Cursor), DeltaMemberWrite(Object.template Get<_I>(), Cursor)) : void()),
+     ...);
+}
+
+//
+// decoding dispatches on the index from the input
+//
+
+template <typename _Ty>
+void DeltaReadImpl(Tracked<_Ty> &Object, BinaryReader &Reader);
+
+template <typename _Ty, size_t _I>
+void DeltaMemberRead(Tracked<_Ty> &Object, BinaryReader &Reader)
+{
+    auto &Member = Object.template Modify<_I>();
+
+    if constexpr (IsTracked<RemoveCVRType<decltype(Member)>>) {
+        DeltaReadImpl(Member, Reader);
+    }
+    else {
+        BinaryReadImpl(Member, Reader);
+    }
+}
+
+template <typename _Ty, size_t... _I>
+constexpr auto MakeDeltaReaders(std::index_sequence<_I...>)
+{
+    using Reader = void (*)(Tracked<_Ty> &, BinaryReader &);
+
+    return std::array<Reader, sizeof...(_I)>{&DeltaMemberRead<_Ty, _I>...};
+}
+
+template <typename _Ty>
+struct DeltaReaders {
+    static constexpr auto Table = MakeDeltaReaders<_Ty>(std::make_index_sequence<Counts<_Ty>()>{});
+};
+
+template <typename _Ty>
+void DeltaReadImpl(Tracked<_Ty> &Object, BinaryReader &Reader)
+{
+    uint8_t Changed;
+    Reader.Raw(&Changed, sizeof(Changed));
+
+    for (; Changed != 0; Changed--) {
+        uint8_t Index;
+        Reader.Raw(&Index, sizeof(Index));
+        if (Index >= Counts<_Ty>()) {
+            throw std::out_of_range("delta member index out of range");
+        }
+        DeltaReaders<_Ty>::Table[Index](Object, Reader);
+    }
+}
+
+} // namespace DETAIL
+
+//
+// MAKE_REFL object with a dirty bit per member, set by Modify / Set / Replace.
+// reflects as the wrapped type (binary, json, hash, fields), reads through Visits are not tracked.
+//
+
+template <typename _Ty>
+class Tracked
+{
+public:
+    static_assert(DETAIL::IsUserRefl<_Ty>, "Tracked needs a MAKE_REFL type");
+
+    static constexpr size_t Count = Counts<_Ty>();
+    static_assert(Count <= 64, "one dirty bit per member");
+
+    // default: clean, the receiver starts from the same state
+    Tracked() = default;
+
+    // new value: everything dirty
+    explicit Tracked(_Ty Value) : Value_(std::move(Value)) { MarkAll(); }
+
+    const _Ty &Value() const { return Value_; }
+    const _Ty &operator*() const { return Value_; }
+    const _Ty *operator->() const { return &Value_; }
+
+    // member _I in declaration order
+    template <size_t _I>
+    const auto &Get() const
+    {
+        return _Ty::REFL::template GET<Count - 1 - _I>(Value_);
+    }
+
+    template <size_t _I>
+    auto &Modify()
+    {
+        Dirty_ |= uint64_t(1) << _I;
+        return _Ty::REFL::template GET<Count - 1 - _I>(Value_);
+    }
+
+    template <size_t _I, typename _Arg>
+    void Set(_Arg &&Arg)
+    {
+        Modify<_I>() = std::forward<_Arg>(Arg);
+    }
+
+    void Replace(_Ty Value)
+    {
+        Value_ = std::move(Value);
+        MarkAll();
+    }
+
+    uint64_t DirtyMask() const { return Dirty_; }
+    bool     Dirty() const { return Dirty_ != 0; }
+
+    // after the delta went out. unchanged nested objects are not visited
+    void Clean() { CleanMembers(std::make_index_sequence<Count>{}); }
+
+    void MarkAll()
+    {
+        Dirty_ = Count == 64 ? ~uint64_t(0) : (uint64_t(1) << Count) - 1;
+        Foreach(Value_, [](auto &&Member) {
+            if constexpr (DETAIL::IsTracked<DETAIL::RemoveCVRType<decltype(Member)>>) {
+                Member.MarkAll();
+            }
+        });
+    }
+
+    // forwards to _Ty::REFL, with Tracked as the object
+    struct REFL {
+        static Tracked &MAKE_FLAG(Tracked &Object) { return Object; }
+
+        static constexpr size_t COUNTS() { return Count; }
+
+        template <typename _Object, typename _Visitor>
+        static constexpr decltype(auto) VISIT(_Object &Object, _Visitor &&Visitor)
+        {
+            return _Ty::REFL::VISIT(Object.Value_, std::forward<_Visitor>(Visitor));
+        }
+
+        template <size_t _I>
+        static constexpr auto &GET_NAME()
+        {
+            return _Ty::REFL::template GET_NAME<_I>();
+        }
+
+        template <size_t _I>
+        static auto &GET(Tracked &Object)
+        {
+            return _Ty::REFL::template GET<_I>(Object.Value_);
+        }
+
+        template <size_t _I>
+        static const auto &GET(const Tracked &Object)
+        {
+            return _Ty::REFL::template GET<_I>(Object.Value_);
+        }
+    };
+
+private:
+    template <size_t... _I>
+    void CleanMembers(std::index_sequence<_I...>)
+    {
+        const uint64_t Mask = Dirty_;
+        Dirty_              = 0;
+        (CleanMember<_I>(Mask), ...);
+    }
+
+    template <size_t _I>
+    void CleanMember(uint64_t Mask)
+    {
+        if constexpr (DETAIL::IsTracked<DETAIL::RemoveCVRType<decltype(Get<_I>())>>) {
+            if (Mask >> _I & 1) {
+                _Ty::REFL::template GET<Count - 1 - _I>(Value_).Clean();
+            }
+        }
+    }
+
+    _Ty      Value_{};
+    uint64_t Dirty_ = 0;
+};
+
+//
+// delta replication of Tracked objects, binary format for the values.
+//  sender:   DeltaEncode(State, Buffer) -> only dirty members, then State.Clean()
+//  receiver: DeltaApply(Replica, Buffer) -> applied members are marked dirty, for relaying
+//
+
+template <typename _Ty>
+size_t DeltaSize(const Tracked<_Ty> &Object)
+{
+    return DETAIL::DeltaSizeImpl(Object, std::make_index_sequence<Tracked<_Ty>::Count>{});
+}
+
+// Buffer must hold DeltaSize(Object) bytes, returns the bytes written
+template <typename _Ty>
+size_t DeltaWrite(const Tracked<_Ty> &Object, void *Buffer)
+{
+    char *Cursor = static_cast<char *>(Buffer);
+    DETAIL::DeltaWriteImpl(Object, Cursor, std::make_index_sequence<Tracked<_Ty>::Count>{});
+    return size_t(Cursor - static_cast<char *>(Buffer));
+}
+
+// returns the bytes consumed, throws std::out_of_range on truncated input
+template <typename _Ty>
+size_t DeltaRead(Tracked<_Ty> &Object, const void *Buffer, size_t Size)
+{
+    DETAIL::BinaryReader Reader{static_cast<const char *>(Buffer), static_cast<const char *>(Buffer) + Size};
+    DETAIL::DeltaReadImpl(Object, Reader);
+    return size_t(Reader.Cursor - static_cast<const char *>(Buffer));
+}
+
+template <typename _Ty, typename _Buffer>
+void DeltaEncode(Tracked<_Ty> &Object, _Buffer &Buffer)
+{
+    Buffer.resize(DeltaSize(Object));
+    DeltaWrite(Object, Buffer.data());
+    Object.Clean();
+}
+
+template <typename _Ty, typename _Buffer>
+void DeltaApply(Tracked<_Ty> &Object, const _Buffer &Buffer)
+{
+    DeltaRead(Object, Buffer.data(), Buffer.size());
+}
+
+} // namespace REFL
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "refl.hpp"
+
+namespace REFL
+{
+
+//
+// runtime description of one member
+//
+
+struct FieldInfo {
+    std::string_view Name; // empty for plain aggregates
+    TYPE_ID          TypeId;
+    size_t           Size;
+    size_t           Offset;
+    const void      *TypeKey; // identity of the exact member type
+};
+
+namespace DETAIL
+{
+
+template <typename _Ty>
+inline constexpr char TypeKeyOf = 0;
+
+//
+// member types without an object: Visits in unevaluated context
+//
+
+template <typename... _Args>
+struct TypeList {
+};
+
+struct TypeListVisitor {
+    template <typename... _Args>
+    constexpr auto operator()(_Args &&...) const
+    {
+        return TypeList<RemoveCVRType<_Args>...>{};
+    }
+};
+
+template <typename _Ty>
+using MemberTypes = decltype(Visits(std::declval<_Ty &>(), TypeListVisitor{}));
+
+template <typename _Ty, size_t... _I>
+constexpr std::array<std::string_view, sizeof...(_I)> MakeNames(std::index_sequence<_I...>)
+{
+    if constexpr (IsUserRefl<_Ty>) {
+        // GET_NAME<I> counts from the last member, GET_NAME_I from the first
+        return {std::string_view(_Ty::REFL::template GET_NAME<sizeof...(_I) - 1 - _I>())...};
+    }
+    else {
+        return {};
+    }
+}
+
+//
+// names, types and sizes are constant expressions; offsets are taken once from a probe object
+//
+
+template <typename _Ty, typename... _Args>
+std::array<FieldInfo, sizeof...(_Args)> MakeFieldTable(TypeList<_Args...>)
+{
+    static_assert(std::is_default_constructible_v<_Ty>, "field table needs a default constructible probe");
+
+    constexpr auto Names = MakeNames<_Ty>(std::index_sequence_for<_Args...>{});
+
+    std::array<FieldInfo, sizeof...(_Args)> Table{};
+    size_t                                  Index = 0;
+
+    ((Table[Index] = FieldInfo{Names[Index], GetTypeId<_Args>(), sizeof(_Args), 0, &TypeKeyOf<_Args>}, Index++),
+     ...);
+
+    _Ty Probe{};
+    Index = 0;
+    Foreach(Probe, [&](auto &&Member) {
+        Table[Index++].Offset = size_t(reinterpret_cast<const char *>(&Member) - reinterpret_cast<const char *>(&Probe));
+    });
+
+    return Table;
+}
+
+//
+// perfect hash over the member names, searched at compile time
+//
+
+constexpr uint32_t NameHash(std::string_view Name, uint32_t Seed)
+{
+    uint32_t Hash = 2166136261u ^ Seed;
+    for (char Char : Name) {
+        Hash ^= uint8_t(Char);
+        Hash *= 16777619u;
+    }
+    return Hash ^ (Hash >> 15);
+}
+
+template <size_t _Count>
+constexpr size_t NameSlots()
+{
+    size_t Slots = 1;
+    while (Slots < 2 * _Count) {
+        Slots *= 2;
+    }
+    return Slots;
+}
+
+template <size_t _Count>
+constexpr uint32_t FindNameSeed(const std::array<std::string_view, _Count> &Names)
+{
+    constexpr size_t Mask = NameSlots<_Count>() - 1;
+
+    for (uint32_t Seed = 0; Seed != 1u << 16; Seed++) {
+        bool Used[Mask + 1] = {};
+        bool Collision      = false;
+
+        for (size_t Index = 0; Index != _Count && !Collision; Index++) {
+            const size_t Slot = NameHash(Names[Index], Seed) & Mask;
+            Collision         = Used[Slot];
+            Used[Slot]        = true;
+        }
+
+        if (!Collision) {
+            return Seed;
+        }
+    }
+
+    return uint32_t(-1);
+}
+
+template <typename _Ty>
+struct NameIndex {
+    static constexpr size_t Count = Counts<_Ty>();
+    static constexpr size_t Mask  = NameSlots<Count>() - 1;
+
+    static constexpr std::array<std::string_view, Count> Names = MakeNames<_Ty>(std::make_index_sequence<Count>{});
+
+    static constexpr uint32_t Seed = FindNameSeed<Count>(Names);
+    static_assert(Seed != uint32_t(-1), "no perfect hash seed for the member names");
+
+    // slot -> member index + 1, 0 is empty
+    static constexpr std::array<uint8_t, Mask + 1> Slots = [] {
+        std::array<uint8_t, Mask + 1> Slots{};
+        for (size_t Index = 0; Index != Count; Index++) {
+            Slots[NameHash(Names[Index], Seed) & Mask] = uint8_t(Index + 1);
+        }
+        return Slots;
+    }();
+
+    static constexpr size_t Find(std::string_view Name)
+    {
+        const size_t Slot = Slots[NameHash(Name, Seed) & Mask];
+        return Slot != 0 && Names[Slot - 1] == Name ? Slot - 1 : size_t(-1);
+    }
+};
+
+} // namespace DETAIL
+
+//
+// field table of a reflected type, built on first use
+//
+
+template <typename _Ty>
+const std::array<FieldInfo, Counts<_Ty>()> &Fields()
+{
+    using Type = DETAIL::RemoveCVRType<_Ty>;
+
+    static const auto Table = DETAIL::MakeFieldTable<Type>(DETAIL::MemberTypes<Type>{});
+    return Table;
+}
+
+//
+// name -> member index, size_t(-1) if missing. MAKE_REFL types only, usable in constant expressions.
+//
+
+template <typename _Ty>
+constexpr size_t FieldIndex(std::string_view Name)
+{
+    using Type = DETAIL::RemoveCVRType<_Ty>;
+
+    static_assert(DETAIL::IsUserRefl<Type>, "member names need MAKE_REFL");
+    return DETAIL::NameIndex<Type>::Find(Name);
+}
+
+//
+// type erased member reference
+//
+
+template <typename _Void>
+struct BasicFieldRef {
+    _Void           *Data = nullptr;
+    const FieldInfo *Info = nullptr;
+
+    explicit operator bool() const { return Data != nullptr; }
+
+    // nullptr unless the member is exactly _Ty
+    template <typename _Ty>
+    auto As() const
+    {
+        using Pointer = std::conditional_t<std::is_const_v<_Void>, const _Ty *, _Ty *>;
+        return Data && Info->TypeKey == &DETAIL::TypeKeyOf<_Ty> ? static_cast<Pointer>(Data) : nullptr;
+    }
+};
+
+using FieldRef      = BasicFieldRef<void>;
+using ConstFieldRef = BasicFieldRef<const void>;
+
+template <typename _Ty>
+auto GetField(_Ty &Object, size_t Index)
+{
+    using Ref = std::conditional_t<std::is_const_v<_Ty>, ConstFieldRef, FieldRef>;
+
+    const auto &Table = Fields<std::remove_const_t<_Ty>>();
+    if (Index >= Table.size()) {
+        return Ref{};
+    }
+
+    auto *Base = reinterpret_cast<std::conditional_t<std::is_const_v<_Ty>, const char, char> *>(&Object);
+    return Ref{Base + Table[Index].Offset, &Table[Index]};
+}
+
+template <typename _Ty>
+auto GetField(_Ty &Object, std::string_view Name)
+{
+    return GetField(Object, FieldIndex<_Ty>(Name));
+}
+
+} // namespace REFL
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define REFL_HASH_SSE2 1
+#endif
+
+#include "refl_field.hpp"
+
+namespace REFL
+{
+namespace DETAIL
+{
+
+//
+// 64 bit finalizer, every input bit reaches every output bit
+//
+
+constexpr uint64_t HashMix(uint64_t Value)
+{
+    Value ^= Value >> 32;
+    Value *= 0xd6e8feb86659fd93ull;
+    Value ^= Value >> 32;
+    Value *= 0xd6e8feb86659fd93ull;
+    Value ^= Value >> 32;
+    return Value;
+}
+
+// order dependent: (a, b) and (b, a) hash differently
+constexpr uint64_t HashCombine(uint64_t Seed, uint64_t Value)
+{
+    return HashMix(Seed ^ (Value + 0x9e3779b97f4a7c15ull));
+}
+
+//
+// bytes: up to 16 by two overlapping loads, longer in 32 byte stripes of four
+// 64 bit lanes, lane += lo32(x) * hi32(x), x = data ^ key (pmuludq with SSE2).
+//
+
+inline uint64_t Load64(const char *Data)
+{
+    uint64_t Value;
+    std::memcpy(&Value, Data, sizeof(Value));
+    return Value;
+}
+
+inline uint32_t Load32(const char *Data)
+{
+    uint32_t Value;
+    std::memcpy(&Value, Data, sizeof(Value));
+    return Value;
+}
+
+alignas(16) constexpr uint64_t HashStripeKey[4] = {
+    0xbe4ba423396cfeb8ull, 0x1cad21f72c81017cull, 0xdb979083e96dd4deull, 0x1f67b3b7a4a44072ull};
+
+inline void HashStripe(uint64_t *Lanes, const char *Data)
+{
+#if defined(REFL_HASH_SSE2)
+    for (size_t Half = 0; Half != 2; Half++) {
+        const __m128i Bytes   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Data + 16 * Half));
+        const __m128i Key     = _mm_load_si128(reinterpret_cast<const __m128i *>(HashStripeKey + 2 * Half));
+        const __m128i Mixed   = _mm_xor_si128(Bytes, Key);
+        const __m128i Product = _mm_mul_epu32(Mixed, _mm_srli_epi64(Mixed, 32));
+        const __m128i Swapped = _mm_shuffle_epi32(Bytes, _MM_SHUFFLE(1, 0, 3, 2));
+
+        __m128i *Lane = reinterpret_cast<__m128i *>(Lanes + 2 * Half);
+        _mm_store_si128(Lane, _mm_add_epi64(_mm_load_si128(Lane), _mm_add_epi64(Product, Swapped)));
+    }
+#else
+    for (size_t Index = 0; Index != 4; Index++) {
+        const uint64_t Bytes = Load64(Data + 8 * Index);
+        const uint64_t Mixed = Bytes ^ HashStripeKey[Index];
+        Lanes[Index] += (Mixed & 0xffffffffull) * (Mixed >> 32);
+        Lanes[Index ^ 1] += Bytes;
+    }
+#endif
+}
+
+inline uint64_t HashBytes(const void *Bytes, size_t Size, uint64_t Seed = 0)
+{
+    const char *Data = static_cast<const char *>(Bytes);
+
+    if (Size <= 16) {
+        uint64_t Low = 0, High = 0;
+        if (Size >= 8) {
+            Low  = Load64(Data);
+            High = Load64(Data + Size - 8);
+        }
+        else if (Size >= 4) {
+            Low  = Load32(Data);
+            High = Load32(Data + Size - 4);
+        }
+        else if (Size != 0) {
+            Low = uint64_t(uint8_t(Data[0])) << 16 | uint64_t(uint8_t(Data[Size / 2])) << 8 | uint8_t(Data[Size - 1]);
+        }
+        return HashMix(HashMix(Low ^ Seed ^ HashStripeKey[0]) ^ High ^ (Size * 0x9e3779b97f4a7c15ull));
+    }
+
+    alignas(16) uint64_t Lanes[4] = {Seed, Seed ^ HashStripeKey[1], Seed ^ HashStripeKey[2], Size};
+
+    size_t Offset = 0;
+    for (; Offset + 32 < Size; Offset += 32) {
+        HashStripe(Lanes, Data + Offset);
+    }
+
+    // the last stripe overlaps the previous one, or is a zero padded copy for 17 .. 31 bytes
+    if (Size >= 32) {
+        HashStripe(Lanes, Data + Size - 32);
+    }
+    else {
+        char Tail[32] = {};
+        std::memcpy(Tail, Data, Size);
+        HashStripe(Lanes, Tail);
+    }
+
+    uint64_t Hash = Size * 0x9e3779b97f4a7c15ull;
+    for (uint64_t Lane : Lanes) {
+        Hash = HashCombine(Hash, Lane);
+    }
+    return Hash;
+}
+
+//
+// bytes are the value: padding free and no floating point (0.0 == -0.0, NaN != NaN)
+//
+
+template <typename _Ty>
+constexpr bool HasFloatImpl();
+
+struct HasFloatVisitor {
+    template <typename... _Args>
+    constexpr auto operator()(_Args &&...) const
+    {
+        return std::bool_constant<(false || ... || HasFloatImpl<RemoveCVRType<_Args>>())>{};
+    }
+};
+
+template <typename _Ty, size_t... _I>
+constexpr bool HasFloatTuple(std::index_sequence<_I...>)
+{
+    return (false || ... || HasFloatImpl<std::tuple_element_t<_I, _Ty>>());
+}
+
+template <typename _Ty>
+constexpr bool HasFloatImpl()
+{
+    if constexpr (std::is_floating_point_v<_Ty>) {
+        return true;
+    }
+    else if constexpr (std::is_array_v<_Ty>) {
+        return HasFloatImpl<std::remove_all_extents_t<_Ty>>();
+    }
+    else if constexpr (IsTupleLike<_Ty> && std::is_trivially_copyable_v<_Ty>) {
+        return HasFloatTuple<_Ty>(std::make_index_sequence<std::tuple_size_v<_Ty>>());
+    }
+    else if constexpr (IsVisitable<_Ty> && std::is_trivially_copyable_v<_Ty>) {
+        return decltype(Visits(std::declval<_Ty &>(), HasFloatVisitor{}))::value;
+    }
+
+    return false;
+}
+
+template <typename _Ty>
+constexpr bool IsBytewise = IsPaddingFree<_Ty> && !HasFloatImpl<_Ty>();
+
+template <typename _Ty, typename = void>
+struct IsUnorderedImpl : std::false_type {
+};
+
+template <typename _Ty>
+struct IsUnorderedImpl<_Ty, std::void_t<typename _Ty::hasher>> : std::true_type {
+};
+
+//
+// hash
+//
+
+template <typename _Ty>
+uint64_t HashImpl(const _Ty &Object)
+{
+    if constexpr (IsBytewise<_Ty>) {
+        if constexpr (std::is_integral_v<_Ty> || std::is_enum_v<_Ty>) {
+            return HashMix(uint64_t(Object));
+        }
+        else {
+            return HashBytes(&Object, sizeof(_Ty));
+        }
+    }
+    else if constexpr (std::is_floating_point_v<_Ty>) {
+        // +0.0 and -0.0 compare equal
+        const double Value = Object == 0 ? 0.0 : double(Object);
+        return HashBytes(&Value, sizeof(Value));
+    }
+    else if constexpr (IsStringType<_Ty>) {
+        return HashBytes(Object.data(), Object.length() * sizeof(typename _Ty::value_type));
+    }
+    else if constexpr (IsUnorderedImpl<_Ty>::value) {
+        // iteration order is not part of the value: commutative sum
+        uint64_t Sum = 0;
+        for (auto &&Item : Object) {
+            if constexpr (IsMapType<_Ty>) {
+                Sum += HashCombine(HashImpl(Item.first), HashImpl(Item.second));
+            }
+            else {
+                Sum += HashImpl(Item);
+            }
+        }
+        return HashCombine(HashMix(Sum), std::size(Object));
+    }
+    else if constexpr (IsContainerType<_Ty> || std::is_array_v<_Ty>) {
+        using Element = RemoveCVRType<decltype(*std::begin(Object))>;
+
+        if constexpr (IsBytewise<Element> && IsContiguousImpl<_Ty>::value) {
+            return HashBytes(std::data(Object), std::size(Object) * sizeof(Element), std::size(Object));
+        }
+        else {
+            uint64_t Hash = std::size(Object);
+            for (auto &&Item : Object) {
+                if constexpr (IsMapType<_Ty>) {
+                    Hash = HashCombine(HashCombine(Hash, HashImpl(Item.first)), HashImpl(Item.second));
+                }
+                else {
+                    Hash = HashCombine(Hash, HashImpl(Item));
+                }
+            }
+            return Hash;
+        }
+    }
+    else if constexpr (std::is_class_v<_Ty>) {
+        uint64_t Hash = Counts<_Ty>();
+        Foreach(Object, [&](auto &&Member) { Hash = HashCombine(Hash, HashImpl(Member)); });
+        return Hash;
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be hashed");
+    }
+}
+
+//
+// equality, consistent with HashImpl
+//
+
+template <typename _Ty>
+bool EqualImpl(const _Ty &Left, const _Ty &Right)
+{
+    if constexpr (IsBytewise<_Ty>) {
+        return std::memcmp(&Left, &Right, sizeof(_Ty)) == 0;
+    }
+    else if constexpr (std::is_floating_point_v<_Ty> || IsStringType<_Ty>) {
+        return Left == Right;
+    }
+    else if constexpr (IsUnorderedImpl<_Ty>::value) {
+        if (std::size(Left) != std::size(Right)) {
+            return false;
+        }
+
+        // keys are found through the container, elements and mapped values compare member-wise.
+        // equal keys are adjacent, one group of the left side is matched against the right at a time
+        auto KeyOf = [](auto &&Item) -> decltype(auto) {
+            if constexpr (IsMapType<_Ty>) {
+                return (Item.first);
+            }
+            else {
+                return (Item);
+            }
+        };
+        auto Same = [](auto &&LeftItem, auto &&RightItem) {
+            if constexpr (IsMapType<_Ty>) {
+                return EqualImpl(LeftItem.second, RightItem.second);
+            }
+            else {
+                return EqualImpl(LeftItem, RightItem);
+            }
+        };
+
+        for (auto Item = Left.begin(); Item != Left.end();) {
+            const auto LeftRange  = Left.equal_range(KeyOf(*Item));
+            const auto RightRange = Right.equal_range(KeyOf(*Item));
+            if (!std::is_permutation(LeftRange.first, LeftRange.second, RightRange.first, RightRange.second, Same)) {
+                return false;
+            }
+            Item = LeftRange.second;
+        }
+        return true;
+    }
+    else if constexpr (IsContainerType<_Ty> || std::is_array_v<_Ty>) {
+        if (std::size(Left) != std::size(Right)) {
+            return false;
+        }
+
+        auto Other = std::begin(Right);
+        for (auto &&Item : Left) {
+            bool Equal;
+            if constexpr (IsMapType<_Ty>) {
+                Equal = EqualImpl(Item.first, Other->first) && EqualImpl(Item.second, Other->second);
+            }
+            else {
+                Equal = EqualImpl(Item, *Other);
+            }
+            if (!Equal) {
+                return false;
+            }
+            ++Other;
+        }
+        return true;
+    }
+    else if constexpr (std::is_class_v<_Ty>) {
+        return Visits(Left, [&](auto &...LeftMembers) {
+            return Visits(Right, [&](auto &...RightMembers) { return (EqualImpl(LeftMembers, RightMembers) && ...); });
+        });
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be compared");
+    }
+}
+
+} // namespace DETAIL
+
+//
+// member-wise hash and equality of reflected types, for unordered containers:
+//  std::unordered_map<Key, Value, REFL::Hash<Key>, REFL::EqualTo<Key>>
+// padding free types without floating point members hash and compare as raw bytes.
+//
+
+template <typename _Ty>
+struct Hash {
+    size_t operator()(const _Ty &Object) const { return size_t(DETAIL::HashImpl(Object)); }
+};
+
+template <typename _Ty>
+struct EqualTo {
+    bool operator()(const _Ty &Left, const _Ty &Right) const { return DETAIL::EqualImpl(Left, Right); }
+};
+
+} // namespace REFL
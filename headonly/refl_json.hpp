@@ -0,0 +1,710 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define REFL_JSON_SSE2 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "refl_field.hpp"
+
+namespace REFL
+{
+
+//
+// parse error, Offset is the byte position in the input
+//
+
+struct JsonError : std::runtime_error {
+    size_t Offset;
+
+    JsonError(const char *What, size_t Offset) : std::runtime_error(What), Offset(Offset) {}
+};
+
+namespace DETAIL
+{
+
+//
+// 16 byte scanning. string runs stop at '"', '\\' and control characters,
+// value skipping stops at '"' and brackets only.
+//
+
+inline unsigned LowestBit(unsigned Mask)
+{
+#if defined(_MSC_VER)
+    unsigned long Index;
+    _BitScanForward(&Index, Mask);
+    return unsigned(Index);
+#else
+    return unsigned(__builtin_ctz(Mask));
+#endif
+}
+
+inline bool IsStringSpecial(char Char)
+{
+    return Char == '"' || Char == '\\' || uint8_t(Char) < 0x20;
+}
+
+inline bool IsStructural(char Char)
+{
+    return Char == '"' || Char == '{' || Char == '}' || Char == '[' || Char == ']';
+}
+
+inline const char *FindStringSpecial(const char *Cursor, const char *End)
+{
+#if defined(REFL_JSON_SSE2)
+    const __m128i Quote   = _mm_set1_epi8('"');
+    const __m128i Slash   = _mm_set1_epi8('\\');
+    const __m128i Control = _mm_set1_epi8(0x1f);
+
+    for (; End - Cursor >= 16; Cursor += 16) {
+        const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Cursor));
+        const __m128i Hits  = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Bytes, Quote), _mm_cmpeq_epi8(Bytes, Slash)),
+                                          _mm_cmpeq_epi8(_mm_min_epu8(Bytes, Control), Bytes));
+
+        if (const unsigned Mask = unsigned(_mm_movemask_epi8(Hits))) {
+            return Cursor + LowestBit(Mask);
+        }
+    }
+#endif
+    while (Cursor != End && !IsStringSpecial(*Cursor)) {
+        Cursor++;
+    }
+    return Cursor;
+}
+
+inline const char *FindStructural(const char *Cursor, const char *End)
+{
+#if defined(REFL_JSON_SSE2)
+    const __m128i Quote       = _mm_set1_epi8('"');
+    const __m128i OpenCurly   = _mm_set1_epi8('{');
+    const __m128i CloseCurly  = _mm_set1_epi8('}');
+    const __m128i OpenSquare  = _mm_set1_epi8('[');
+    const __m128i CloseSquare = _mm_set1_epi8(']');
+
+    for (; End - Cursor >= 16; Cursor += 16) {
+        const __m128i Bytes  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Cursor));
+        const __m128i Curly  = _mm_or_si128(_mm_cmpeq_epi8(Bytes, OpenCurly), _mm_cmpeq_epi8(Bytes, CloseCurly));
+        const __m128i Square = _mm_or_si128(_mm_cmpeq_epi8(Bytes, OpenSquare), _mm_cmpeq_epi8(Bytes, CloseSquare));
+        const __m128i Hits   = _mm_or_si128(_mm_cmpeq_epi8(Bytes, Quote), _mm_or_si128(Curly, Square));
+
+        if (const unsigned Mask = unsigned(_mm_movemask_epi8(Hits))) {
+            return Cursor + LowestBit(Mask);
+        }
+    }
+#endif
+    while (Cursor != End && !IsStructural(*Cursor)) {
+        Cursor++;
+    }
+    return Cursor;
+}
+
+//
+// writer
+//
+
+inline void JsonWriteString(std::string_view Text, std::string &Out)
+{
+    static constexpr char Hex[] = "0123456789abcdef";
+
+    const char *Cursor = Text.data();
+    const char *End    = Cursor + Text.size();
+
+    Out.push_back('"');
+    for (;;) {
+        const char *Stop = FindStringSpecial(Cursor, End);
+        Out.append(Cursor, Stop);
+        if (Stop == End) {
+            break;
+        }
+
+        switch (*Stop) {
+        case '"': Out.append("\\\""); break;
+        case '\\': Out.append("\\\\"); break;
+        case '\n': Out.append("\\n"); break;
+        case '\r': Out.append("\\r"); break;
+        case '\t': Out.append("\\t"); break;
+        case '\b': Out.append("\\b"); break;
+        case '\f': Out.append("\\f"); break;
+        default: {
+            const char Escape[] = {'\\', 'u', '0', '0', Hex[uint8_t(*Stop) >> 4], Hex[*Stop & 0xf]};
+            Out.append(Escape, sizeof(Escape));
+        }
+        }
+        Cursor = Stop + 1;
+    }
+    Out.push_back('"');
+}
+
+template <typename _Ty>
+void JsonWriteNumber(_Ty Value, std::string &Out)
+{
+    if constexpr (std::is_floating_point_v<_Ty>) {
+        // no NaN / Infinity in JSON
+        if (Value - Value != Value - Value) {
+            Out.append("null");
+            return;
+        }
+    }
+
+    char Buffer[32];
+    auto Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Value);
+    Out.append(Buffer, Result.ptr);
+}
+
+template <typename _Ty>
+void JsonWriteImpl(const _Ty &Object, std::string &Out);
+
+template <typename _Ty, size_t... _I, typename... _Members>
+void JsonWriteMembers(std::index_sequence<_I...>, std::string &Out, const _Members &...Members)
+{
+    const auto &Names = NameIndex<_Ty>::Names;
+
+    Out.push_back('{');
+    ((_I != 0 ? Out.push_back(',') : void(),
+      Out.push_back('"'),
+      Out.append(Names[_I]),
+      Out.append("\":"),
+      JsonWriteImpl(Members, Out)),
+     ...);
+    Out.push_back('}');
+}
+
+template <typename _Ty>
+void JsonWriteImpl(const _Ty &Object, std::string &Out)
+{
+    if constexpr (std::is_same_v<_Ty, bool>) {
+        Out.append(Object ? "true" : "false");
+    }
+    else if constexpr (std::is_enum_v<_Ty>) {
+        JsonWriteNumber(std::underlying_type_t<_Ty>(Object), Out);
+    }
+    else if constexpr (std::is_arithmetic_v<_Ty>) {
+        JsonWriteNumber(Object, Out);
+    }
+    else if constexpr (IsStringType<_Ty>) {
+        static_assert(std::is_same_v<typename _Ty::value_type, char>, "json strings are utf-8");
+        JsonWriteString(std::string_view(Object.data(), Object.length()), Out);
+    }
+    else if constexpr (IsMapType<_Ty>) {
+        static_assert(IsStringType<typename _Ty::key_type>, "json object keys are strings");
+
+        Out.push_back('{');
+        bool First = true;
+        for (auto &&[Key, Value] : Object) {
+            if (!First) {
+                Out.push_back(',');
+            }
+            First = false;
+            JsonWriteImpl(Key, Out);
+            Out.push_back(':');
+            JsonWriteImpl(Value, Out);
+        }
+        Out.push_back('}');
+    }
+    else if constexpr (IsContainerType<_Ty> || std::is_array_v<_Ty>) {
+        Out.push_back('[');
+        bool First = true;
+        for (auto &&Item : Object) {
+            if (!First) {
+                Out.push_back(',');
+            }
+            First = false;
+            JsonWriteImpl(Item, Out);
+        }
+        Out.push_back(']');
+    }
+    else if constexpr (IsUserRefl<_Ty>) {
+        Visits(Object, [&](auto &...Members) {
+            JsonWriteMembers<_Ty>(std::index_sequence_for<decltype(Members)...>{}, Out, Members...);
+        });
+    }
+    else if constexpr (std::is_class_v<_Ty>) {
+        // no member names: positional array
+        Out.push_back('[');
+        bool First = true;
+        Foreach(Object, [&](auto &&Member) {
+            if (!First) {
+                Out.push_back(',');
+            }
+            First = false;
+            JsonWriteImpl(Member, Out);
+        });
+        Out.push_back(']');
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be written as json");
+    }
+}
+
+//
+// streaming reader, parses straight into the target object
+//
+
+class JsonParser
+{
+public:
+    JsonParser(const char *Begin, const char *End) : Cursor(Begin), Begin(Begin), End(End) {}
+
+    [[noreturn]] void Fail(const char *What) const { throw JsonError(What, size_t(Cursor - Begin)); }
+
+    void SkipSpace()
+    {
+        while (Cursor != End && (*Cursor == ' ' || *Cursor == '\n' || *Cursor == '\r' || *Cursor == '\t')) {
+            Cursor++;
+        }
+    }
+
+    char Peek()
+    {
+        SkipSpace();
+        if (Cursor == End) {
+            Fail("json: unexpected end of input");
+        }
+        return *Cursor;
+    }
+
+    void Expect(char Char)
+    {
+        if (Peek() != Char) {
+            Fail("json: unexpected character");
+        }
+        Cursor++;
+    }
+
+    bool Consume(char Char)
+    {
+        if (Peek() == Char) {
+            Cursor++;
+            return true;
+        }
+        return false;
+    }
+
+    bool Literal(std::string_view Word)
+    {
+        if (size_t(End - Cursor) < Word.size() || std::string_view(Cursor, Word.size()) != Word) {
+            return false;
+        }
+        Cursor += Word.size();
+        return true;
+    }
+
+    // "null" leaves the target untouched
+    bool Null()
+    {
+        return Peek() == 'n' && (Literal("null") || (Fail("json: bad literal"), false));
+    }
+
+    void String(std::string &Out)
+    {
+        Expect('"');
+        Out.clear();
+        for (;;) {
+            const char *Stop = FindStringSpecial(Cursor, End);
+            Out.append(Cursor, Stop);
+            Cursor = Stop;
+            if (Finish(Out)) {
+                return;
+            }
+        }
+    }
+
+    // unescaped keys are views into the input, escaped ones are decoded into Scratch
+    std::string_view Key(std::string &Scratch)
+    {
+        Expect('"');
+
+        const char *First = Cursor;
+        const char *Stop  = FindStringSpecial(Cursor, End);
+        if (Stop != End && *Stop == '"') {
+            Cursor = Stop + 1;
+            return std::string_view(First, size_t(Stop - First));
+        }
+
+        Cursor--;
+        String(Scratch);
+        return Scratch;
+    }
+
+    template <typename _Ty>
+    void Number(_Ty &Value)
+    {
+        SkipSpace();
+
+        const char *First = Cursor;
+        while (Cursor != End && IsNumberChar(*Cursor)) {
+            Cursor++;
+        }
+
+        const auto Result = std::from_chars(First, Cursor, Value);
+        if (Result.ec != std::errc() || Result.ptr != Cursor) {
+            Cursor = First;
+            Fail("json: bad number");
+        }
+    }
+
+    void SkipValue()
+    {
+        const char Char = Peek();
+
+        if (Char == '"') {
+            Cursor++;
+            SkipString();
+        }
+        else if (Char == '{' || Char == '[') {
+            size_t Depth = 0;
+            for (;;) {
+                Cursor = FindStructural(Cursor, End);
+                if (Cursor == End) {
+                    Fail("json: unterminated value");
+                }
+
+                switch (*Cursor++) {
+                case '"': SkipString(); break;
+                case '{':
+                case '[': Depth++; break;
+                default:
+                    if (--Depth == 0) {
+                        return;
+                    }
+                }
+            }
+        }
+        else if (Char == '-' || (Char >= '0' && Char <= '9')) {
+            // held to what a double member would accept
+            double Ignored;
+            Number(Ignored);
+        }
+        else if (!Literal("true") && !Literal("false") && !Literal("null")) {
+            Fail("json: unexpected character");
+        }
+    }
+
+    const char *Cursor;
+    const char *Begin;
+    const char *End;
+
+private:
+    static bool IsNumberChar(char Char)
+    {
+        return (Char >= '0' && Char <= '9') || Char == '-' || Char == '+' || Char == '.' || Char == 'e' ||
+               Char == 'E';
+    }
+
+    // Cursor is on a special character: true at the closing quote, else decodes one escape
+    bool Finish(std::string &Out)
+    {
+        if (Cursor == End) {
+            Fail("json: unterminated string");
+        }
+        if (*Cursor == '"') {
+            Cursor++;
+            return true;
+        }
+        if (*Cursor != '\\' || End - Cursor < 2) {
+            Fail("json: bad character in string");
+        }
+
+        const char Escape = Cursor[1];
+        Cursor += 2;
+
+        switch (Escape) {
+        case '"':
+        case '\\':
+        case '/': Out.push_back(Escape); break;
+        case 'n': Out.push_back('\n'); break;
+        case 'r': Out.push_back('\r'); break;
+        case 't': Out.push_back('\t'); break;
+        case 'b': Out.push_back('\b'); break;
+        case 'f': Out.push_back('\f'); break;
+        case 'u': AppendUtf8(Unicode(), Out); break;
+        default: Fail("json: bad escape");
+        }
+        return false;
+    }
+
+    // code point of a \u escape, Cursor past the "\u": surrogates only as a high, low pair
+    uint32_t Unicode()
+    {
+        const uint32_t Code = Hex4();
+        if (Code >= 0xdc00 && Code < 0xe000) {
+            Fail("json: unpaired surrogate");
+        }
+        if (Code < 0xd800 || Code >= 0xdc00) {
+            return Code;
+        }
+
+        if (!Literal("\\u")) {
+            Fail("json: unpaired surrogate");
+        }
+        const uint32_t Low = Hex4();
+        if (Low < 0xdc00 || Low >= 0xe000) {
+            Fail("json: unpaired surrogate");
+        }
+        return 0x10000 + ((Code - 0xd800) << 10) + (Low - 0xdc00);
+    }
+
+    void SkipString()
+    {
+        for (;;) {
+            Cursor = FindStringSpecial(Cursor, End);
+            if (Cursor == End) {
+                Fail("json: unterminated string");
+            }
+            if (*Cursor == '"') {
+                Cursor++;
+                return;
+            }
+            if (*Cursor != '\\' || End - Cursor < 2) {
+                Fail("json: bad character in string");
+            }
+
+            // escapes are checked like the decoded ones, nothing is kept
+            const char Escape = Cursor[1];
+            Cursor += 2;
+            if (Escape == 'u') {
+                Unicode();
+            }
+            else if (std::string_view("\"\\/nrtbf").find(Escape) == std::string_view::npos) {
+                Fail("json: bad escape");
+            }
+        }
+    }
+
+    uint32_t Hex4()
+    {
+        uint32_t Code = 0;
+        if (End - Cursor < 4 || std::from_chars(Cursor, Cursor + 4, Code, 16).ptr != Cursor + 4) {
+            Fail("json: bad unicode escape");
+        }
+        Cursor += 4;
+        return Code;
+    }
+
+    static void AppendUtf8(uint32_t Code, std::string &Out)
+    {
+        if (Code < 0x80) {
+            Out.push_back(char(Code));
+        }
+        else if (Code < 0x800) {
+            Out.push_back(char(0xc0 | (Code >> 6)));
+            Out.push_back(char(0x80 | (Code & 0x3f)));
+        }
+        else if (Code < 0x10000) {
+            Out.push_back(char(0xe0 | (Code >> 12)));
+            Out.push_back(char(0x80 | ((Code >> 6) & 0x3f)));
+            Out.push_back(char(0x80 | (Code & 0x3f)));
+        }
+        else {
+            Out.push_back(char(0xf0 | (Code >> 18)));
+            Out.push_back(char(0x80 | ((Code >> 12) & 0x3f)));
+            Out.push_back(char(0x80 | ((Code >> 6) & 0x3f)));
+            Out.push_back(char(0x80 | (Code & 0x3f)));
+        }
+    }
+};
+
+template <typename _Ty>
+void JsonReadImpl(_Ty &Object, JsonParser &Parser);
+
+//
+// member index -> reader, keys are resolved by the perfect hash of refl_field.hpp
+//
+
+template <typename _Ty, size_t... _I>
+constexpr auto MakeJsonReaders(std::index_sequence<_I...>)
+{
+    using Reader = void (*)(_Ty &, JsonParser &);
+
+    return std::array<Reader, sizeof...(_I)>{+[](_Ty &Object, JsonParser &Parser) {
+        JsonReadImpl(_Ty::REFL::template GET<sizeof...(_I) - 1 - _I>(Object), Parser);
+    }...};
+}
+
+template <typename _Ty>
+struct JsonReaders {
+    static constexpr auto Table = MakeJsonReaders<_Ty>(std::make_index_sequence<Counts<_Ty>()>{});
+};
+
+template <typename _Ty>
+void JsonReadImpl(_Ty &Object, JsonParser &Parser)
+{
+    if (Parser.Null()) {
+        return;
+    }
+
+    if constexpr (std::is_same_v<_Ty, bool>) {
+        if (Parser.Literal("true")) {
+            Object = true;
+        }
+        else if (Parser.Literal("false")) {
+            Object = false;
+        }
+        else {
+            Parser.Fail("json: expected a boolean");
+        }
+    }
+    else if constexpr (std::is_enum_v<_Ty>) {
+        std::underlying_type_t<_Ty> Value;
+        Parser.Number(Value);
+        Object = _Ty(Value);
+    }
+    else if constexpr (std::is_arithmetic_v<_Ty>) {
+        Parser.Number(Object);
+    }
+    else if constexpr (IsStringType<_Ty>) {
+        static_assert(std::is_same_v<_Ty, std::string>, "json strings read into std::string");
+        Parser.String(Object);
+    }
+    else if constexpr (IsMapType<_Ty>) {
+        static_assert(std::is_same_v<typename _Ty::key_type, std::string>, "json object keys are strings");
+
+        Object.clear();
+        Parser.Expect('{');
+        if (Parser.Consume('}')) {
+            return;
+        }
+        do {
+            typename _Ty::key_type    Key;
+            typename _Ty::mapped_type Value{};
+            Parser.String(Key);
+            Parser.Expect(':');
+            JsonReadImpl(Value, Parser);
+            Object.insert_or_assign(std::move(Key), std::move(Value));
+        } while (Parser.Consume(','));
+        Parser.Expect('}');
+    }
+    else if constexpr (std::is_array_v<_Ty> || IsTupleLike<_Ty>) {
+        // fixed size: T[N], std::array
+        Parser.Expect('[');
+        bool First = true;
+        for (auto &Item : Object) {
+            if (!First) {
+                Parser.Expect(',');
+            }
+            First = false;
+            JsonReadImpl(Item, Parser);
+        }
+        Parser.Expect(']');
+    }
+    else if constexpr (IsResizableImpl<_Ty>::value) {
+        // existing elements are parsed over, strings inside them keep their capacity
+        size_t Count = 0;
+        Parser.Expect('[');
+        if (!Parser.Consume(']')) {
+            do {
+                if (Count == Object.size()) {
+                    Object.emplace_back();
+                }
+                JsonReadImpl(Object[Count++], Parser);
+            } while (Parser.Consume(','));
+            Parser.Expect(']');
+        }
+        Object.resize(Count);
+    }
+    else if constexpr (IsContainerType<_Ty>) {
+        Object.clear();
+        Parser.Expect('[');
+        if (Parser.Consume(']')) {
+            return;
+        }
+        do {
+            typename _Ty::value_type Item{};
+            JsonReadImpl(Item, Parser);
+            Object.insert(Object.end(), std::move(Item));
+        } while (Parser.Consume(','));
+        Parser.Expect(']');
+    }
+    else if constexpr (IsUserRefl<_Ty>) {
+        // unknown keys are skipped, missing keys keep their value
+        std::string Scratch;
+
+        Parser.Expect('{');
+        if (Parser.Consume('}')) {
+            return;
+        }
+        do {
+            const std::string_view Key = Parser.Key(Scratch);
+            Parser.Expect(':');
+
+            const size_t Index = NameIndex<_Ty>::Find(Key);
+            if (Index != size_t(-1)) {
+                JsonReaders<_Ty>::Table[Index](Object, Parser);
+            }
+            else {
+                Parser.SkipValue();
+            }
+        } while (Parser.Consume(','));
+        Parser.Expect('}');
+    }
+    else if constexpr (std::is_class_v<_Ty>) {
+        bool First = true;
+        Parser.Expect('[');
+        Foreach(Object, [&](auto &&Member) {
+            if (!First) {
+                Parser.Expect(',');
+            }
+            First = false;
+            JsonReadImpl(Member, Parser);
+        });
+        Parser.Expect(']');
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be read from json");
+    }
+}
+
+} // namespace DETAIL
+
+//
+// json mapping
+//  bool, number, std::string    -> literal, number, string
+//  map with string keys         -> object
+//  array, container             -> array
+//  MAKE_REFL class              -> object keyed by member name
+//  plain aggregate              -> array in member order
+//
+
+// appends to Out
+template <typename _Ty>
+void JsonWrite(const _Ty &Object, std::string &Out)
+{
+    DETAIL::JsonWriteImpl(Object, Out);
+}
+
+template <typename _Ty>
+std::string ToJson(const _Ty &Object)
+{
+    std::string Out;
+    JsonWrite(Object, Out);
+    return Out;
+}
+
+// parses one value, only whitespace may follow. throws JsonError
+template <typename _Ty>
+void JsonRead(_Ty &Object, std::string_view Text)
+{
+    DETAIL::JsonParser Parser(Text.data(), Text.data() + Text.size());
+    DETAIL::JsonReadImpl(Object, Parser);
+
+    Parser.SkipSpace();
+    if (Parser.Cursor != Parser.End) {
+        Parser.Fail("json: trailing characters");
+    }
+}
+
+} // namespace REFL
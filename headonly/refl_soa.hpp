@@ -0,0 +1,339 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "refl_field.hpp"
+
+namespace REFL
+{
+
+//
+// column start alignment: one cache line, enough for any vector width
+//
+
+constexpr size_t SoaAlignment = 64;
+
+namespace DETAIL
+{
+
+//
+// storage of one member, cache line aligned. like std::vector, but bool stays bool
+//
+
+template <typename _Ty>
+class AlignedColumn
+{
+public:
+    AlignedColumn() = default;
+
+    AlignedColumn(const AlignedColumn &Other)
+    {
+        Reserve(Other.Size);
+        try {
+            std::uninitialized_copy(Other.Data, Other.Data + Other.Size, Data);
+        }
+        catch (...) {
+            // no destructor runs for a throwing constructor
+            Deallocate(Data);
+            throw;
+        }
+        Size = Other.Size;
+    }
+
+    AlignedColumn(AlignedColumn &&Other) noexcept { Swap(Other); }
+
+    AlignedColumn &operator=(AlignedColumn Other) noexcept
+    {
+        Swap(Other);
+        return *this;
+    }
+
+    ~AlignedColumn()
+    {
+        std::destroy(Data, Data + Size);
+        Deallocate(Data);
+    }
+
+    void Swap(AlignedColumn &Other) noexcept
+    {
+        std::swap(Data, Other.Data);
+        std::swap(Size, Other.Size);
+        std::swap(Capacity, Other.Capacity);
+    }
+
+    void Reserve(size_t Count)
+    {
+        if (Count <= Capacity) {
+            return;
+        }
+
+        _Ty *Buffer = Allocate(Count);
+        try {
+            if constexpr (std::is_nothrow_move_constructible_v<_Ty> || !std::is_copy_constructible_v<_Ty>) {
+                std::uninitialized_move(Data, Data + Size, Buffer);
+            }
+            else {
+                std::uninitialized_copy(Data, Data + Size, Buffer);
+            }
+        }
+        catch (...) {
+            Deallocate(Buffer);
+            throw;
+        }
+
+        std::destroy(Data, Data + Size);
+        Deallocate(Data);
+        Data     = Buffer;
+        Capacity = Count;
+    }
+
+    // room for one more, the only part of EmplaceBack that throws for nothrow constructions
+    void Grow()
+    {
+        if (Size == Capacity) {
+            Reserve(Capacity != 0 ? 2 * Capacity : InitialCapacity);
+        }
+    }
+
+    template <typename... _Args>
+    void EmplaceBack(_Args &&...Args)
+    {
+        Grow();
+
+        ::new (static_cast<void *>(Data + Size)) _Ty(std::forward<_Args>(Args)...);
+        Size++;
+    }
+
+    void PopBack() { std::destroy_at(Data + --Size); }
+
+    void Clear()
+    {
+        std::destroy(Data, Data + Size);
+        Size = 0;
+    }
+
+    _Ty   *Data     = nullptr;
+    size_t Size     = 0;
+    size_t Capacity = 0;
+
+private:
+    // first allocation fills one cache line
+    static constexpr size_t InitialCapacity = sizeof(_Ty) < SoaAlignment ? SoaAlignment / sizeof(_Ty) : 1;
+
+    static _Ty *Allocate(size_t Count)
+    {
+        return static_cast<_Ty *>(::operator new(Count * sizeof(_Ty), std::align_val_t(SoaAlignment)));
+    }
+
+    static void Deallocate(_Ty *Buffer)
+    {
+        if (Buffer != nullptr) {
+            ::operator delete(Buffer, std::align_val_t(SoaAlignment));
+        }
+    }
+};
+
+template <typename _List>
+struct SoaTraits;
+
+template <typename... _Args>
+struct SoaTraits<TypeList<_Args...>> {
+    using Members = std::tuple<_Args...>;
+    using Columns = std::tuple<AlignedColumn<_Args>...>;
+
+    static constexpr bool NothrowMove = (std::is_nothrow_move_constructible_v<_Args> && ...);
+    static constexpr bool Copyable    = (std::is_copy_constructible_v<_Args> && ...);
+};
+
+} // namespace DETAIL
+
+//
+// contiguous view of one column
+//
+
+template <typename _Ty>
+struct ColumnSpan {
+    _Ty   *Data = nullptr;
+    size_t Size = 0;
+
+    _Ty   *begin() const { return Data; }
+    _Ty   *end() const { return Data + Size; }
+    size_t size() const { return Size; }
+
+    _Ty &operator[](size_t Index) const { return Data[Index]; }
+};
+
+//
+// proxy reference to one row. converts to the record (gather), assigns from one (scatter)
+//
+
+template <typename _Soa>
+class SoaRow
+{
+    using Record = typename std::remove_const_t<_Soa>::value_type;
+
+public:
+    SoaRow(_Soa *Owner, size_t Index) : Owner(Owner), Index(Index) {}
+    SoaRow(const SoaRow &) = default;
+
+    template <size_t _I>
+    auto &Get() const
+    {
+        return Owner->template Column<_I>()[Index];
+    }
+
+    operator Record() const
+    {
+        Record Object{};
+        Visits(Object, [&](auto &...Members) { Gather(std::index_sequence_for<decltype(Members)...>{}, Members...); });
+        return Object;
+    }
+
+    const SoaRow &operator=(const Record &Object) const
+    {
+        static_assert(!std::is_const_v<_Soa>, "row of a const SoaVector");
+
+        Visits(Object, [&](auto &...Members) { Scatter(std::index_sequence_for<decltype(Members)...>{}, Members...); });
+        return *this;
+    }
+
+    // copies the values, not the proxy
+    const SoaRow &operator=(const SoaRow &Other) const { return *this = Record(Other); }
+
+private:
+    template <size_t... _I, typename... _Members>
+    void Gather(std::index_sequence<_I...>, _Members &...Members) const
+    {
+        ((Members = Get<_I>()), ...);
+    }
+
+    template <size_t... _I, typename... _Members>
+    void Scatter(std::index_sequence<_I...>, const _Members &...Members) const
+    {
+        ((Get<_I>() = Members), ...);
+    }
+
+    _Soa  *Owner;
+    size_t Index;
+};
+
+//
+// structure of arrays over a reflected type: one aligned array per member, in visit order.
+// columns by name for MAKE_REFL types: Column<FieldIndex<_Ty>("Price")>()
+//
+
+template <typename _Ty>
+class SoaVector
+{
+    using Traits = DETAIL::SoaTraits<DETAIL::MemberTypes<_Ty>>;
+
+public:
+    using value_type = _Ty;
+    using Row        = SoaRow<SoaVector>;
+    using ConstRow   = SoaRow<const SoaVector>;
+
+    template <size_t _I>
+    using MemberType = std::tuple_element_t<_I, typename Traits::Members>;
+
+    static constexpr size_t Count = Counts<_Ty>();
+    static_assert(Count != 0, "SoaVector needs at least one member");
+
+    size_t size() const { return Size_; }
+    bool   empty() const { return Size_ == 0; }
+
+    void reserve(size_t Capacity)
+    {
+        std::apply([&](auto &...Columns) { (Columns.Reserve(Capacity), ...); }, Columns_);
+    }
+
+    void clear()
+    {
+        std::apply([](auto &...Columns) { (Columns.Clear(), ...); }, Columns_);
+        Size_ = 0;
+    }
+
+    void push_back(const _Ty &Object)
+    {
+        Visits(Object, [&](auto &...Members) { EmplaceMembers(Members...); });
+    }
+
+    // a failed push_back leaves Object as it was: members are moved only when no move can throw,
+    // copied otherwise. records with throwing move-only members get the basic guarantee, moved-from
+    void push_back(_Ty &&Object)
+    {
+        if constexpr (Traits::NothrowMove || !Traits::Copyable) {
+            Visits(Object, [&](auto &...Members) { EmplaceMembers(std::move(Members)...); });
+        }
+        else {
+            Visits(Object, [&](auto &...Members) { EmplaceMembers(Members...); });
+        }
+    }
+
+    // one argument per member, in visit order
+    template <typename... _Args>
+    Row emplace_back(_Args &&...Members)
+    {
+        static_assert(sizeof...(_Args) == Count, "emplace_back takes one argument per member");
+
+        EmplaceMembers(std::forward<_Args>(Members)...);
+        return Row(this, Size_ - 1);
+    }
+
+    void pop_back()
+    {
+        std::apply([](auto &...Columns) { (Columns.PopBack(), ...); }, Columns_);
+        Size_--;
+    }
+
+    Row      operator[](size_t Index) { return Row(this, Index); }
+    ConstRow operator[](size_t Index) const { return ConstRow(this, Index); }
+
+    template <size_t _I>
+    ColumnSpan<MemberType<_I>> Column()
+    {
+        auto &Column = std::get<_I>(Columns_);
+        return {Column.Data, Size_};
+    }
+
+    template <size_t _I>
+    ColumnSpan<const MemberType<_I>> Column() const
+    {
+        auto &Column = std::get<_I>(Columns_);
+        return {Column.Data, Size_};
+    }
+
+private:
+    // all columns grow by one, or none does. room is made in every column before the first member
+    // is constructed, so a nothrow construction never consumes an argument and then rolls back
+    template <typename... _Args>
+    void EmplaceMembers(_Args &&...Members)
+    {
+        std::apply([](auto &...Columns) { (Columns.Grow(), ...); }, Columns_);
+
+        size_t Pushed = 0;
+        try {
+            std::apply([&](auto &...Columns) { ((Columns.EmplaceBack(std::forward<_Args>(Members)), Pushed++), ...); },
+                       Columns_);
+        }
+        catch (...) {
+            std::apply(
+                [&](auto &...Columns) {
+                    size_t Index = 0;
+                    ((Index++ < Pushed ? Columns.PopBack() : void()), ...);
+                },
+                Columns_);
+            throw;
+        }
+        Size_++;
+    }
+
+    typename Traits::Columns Columns_;
+    size_t                   Size_ = 0;
+};
+
+} // namespace REFL
@@ -0,0 +1,407 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "refl_bulk.hpp"
+
+namespace REFL
+{
+namespace DETAIL
+{
+
+//
+// member _I in visit order, MAKE_REFL types and plain aggregates
+//
+
+template <size_t _I, typename _Ty>
+auto &MemberAt(_Ty &Object)
+{
+    return Visits(Object, [](auto &...Members) -> auto & { return std::get<_I>(std::tie(Members...)); });
+}
+
+template <typename _Ty, size_t _I>
+using MemberAtType = RemoveCVRType<decltype(MemberAt<_I>(std::declval<_Ty &>()))>;
+
+//
+// sort keys: a byte stream that compares like the members, cut into 64 bit big endian chunks.
+//  BYTE .. QWORD  -> unsigned as is, signed with the sign bit flipped
+//  FLOAT, DOUBLE  -> negative with all bits flipped, positive with the sign bit set (-0 before +0)
+//  STRING         -> groups of 7 bytes + a status byte: 0..7 bytes used in the last group, 8 if more follow
+//
+
+template <typename _Ty>
+constexpr size_t SortKeySize()
+{
+    constexpr TYPE_ID TypeId = GetTypeId<_Ty>();
+
+    if constexpr (TypeId == TYPE_ID::BYTE || TypeId == TYPE_ID::WORD || TypeId == TYPE_ID::DWORD ||
+                  TypeId == TYPE_ID::QWORD || TypeId == TYPE_ID::FLOAT || TypeId == TYPE_ID::DOUBLE) {
+        return sizeof(_Ty);
+    }
+    else if constexpr (TypeId == TYPE_ID::STRING) {
+        return 0;
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "sort keys are integers, enums, floats and strings");
+    }
+}
+
+template <typename _Ty>
+uint64_t SortKeyBits(_Ty Value)
+{
+    constexpr uint64_t SignBit = uint64_t(1) << (sizeof(_Ty) * 8 - 1);
+    constexpr uint64_t Mask    = SignBit | (SignBit - 1);
+
+    if constexpr (std::is_enum_v<_Ty>) {
+        return SortKeyBits(std::underlying_type_t<_Ty>(Value));
+    }
+    else if constexpr (std::is_floating_point_v<_Ty>) {
+        std::conditional_t<sizeof(_Ty) == 4, uint32_t, uint64_t> Bits;
+        std::memcpy(&Bits, &Value, sizeof(Bits));
+        return Bits & SignBit ? ~uint64_t(Bits) & Mask : Bits | SignBit;
+    }
+    else if constexpr (std::is_signed_v<_Ty>) {
+        return (uint64_t(Value) & Mask) ^ SignBit;
+    }
+    else {
+        return uint64_t(Value);
+    }
+}
+
+inline size_t SortKeyGroups(size_t Length)
+{
+    return Length == 0 ? 1 : (Length + 6) / 7;
+}
+
+template <typename _Ty>
+uint64_t SortKeyGroup(const _Ty &String, size_t Group)
+{
+    const size_t Offset = 7 * Group;
+    const size_t Rest   = String.length() - Offset;
+    const size_t Used   = std::min<size_t>(Rest, 7);
+
+    uint64_t Bits = Rest > 7 ? 8 : Rest;
+    for (size_t Index = 0; Index != Used; Index++) {
+        Bits |= uint64_t(uint8_t(String[Offset + Index])) << (56 - 8 * Index);
+    }
+    return Bits;
+}
+
+// Size key bytes in Bits, the first one at byte Offset of the chunk
+inline uint64_t SortKeyShift(uint64_t Bits, int64_t Offset, size_t Size)
+{
+    const int64_t Shift = 8 * (8 - Offset - int64_t(Size));
+    return Shift >= 0 ? Bits << Shift : Bits >> -Shift;
+}
+
+// Position: start of the member relative to the chunk, moved past the member
+template <typename _Ty>
+void SortKeyPlace(const _Ty &Member, int64_t &Position, uint64_t &Chunk)
+{
+    if constexpr (IsStringType<_Ty>) {
+        static_assert(sizeof(typename _Ty::value_type) == 1, "string sort keys are byte strings");
+
+        // groups before the chunk are skipped, at most two overlap it
+        const size_t Groups = SortKeyGroups(Member.length());
+        for (size_t Group = Position < 0 ? size_t(-Position) / 8 : 0;
+             Group < Groups && Position + int64_t(8 * Group) < 8; Group++) {
+            Chunk |= SortKeyShift(SortKeyGroup(Member, Group), Position + int64_t(8 * Group), 8);
+        }
+        Position += int64_t(8 * Groups);
+    }
+    else {
+        constexpr int64_t Size = int64_t(SortKeySize<_Ty>());
+        if (Position > -Size && Position < 8) {
+            Chunk |= SortKeyShift(SortKeyBits(Member), Position, size_t(Size));
+        }
+        Position += Size;
+    }
+}
+
+template <size_t... _Fields, typename _Ty>
+uint64_t SortKeyChunk(const _Ty &Record, size_t Index)
+{
+    int64_t  Position = -int64_t(8 * Index);
+    uint64_t Chunk    = 0;
+    (SortKeyPlace(MemberAt<_Fields>(Record), Position, Chunk), ...);
+    return Chunk;
+}
+
+template <typename _Ty>
+size_t SortKeyMemberLength(const _Ty &Member)
+{
+    if constexpr (IsStringType<_Ty>) {
+        return 8 * SortKeyGroups(Member.length());
+    }
+    else {
+        return SortKeySize<_Ty>();
+    }
+}
+
+template <size_t... _Fields, typename _Ty>
+size_t SortKeyLength(const _Ty &Record)
+{
+    return (size_t(0) + ... + SortKeyMemberLength(MemberAt<_Fields>(Record)));
+}
+
+// keys of at most one chunk need no tie breaking
+template <typename _Ty, size_t... _Fields>
+constexpr bool IsSingleChunk =
+    !(IsStringType<MemberAtType<_Ty, _Fields>> || ...) &&
+    (size_t(0) + ... + SortKeySize<MemberAtType<_Ty, _Fields>>()) <= 8;
+
+//
+// radix sort of (chunk, index) pairs, 8 bits per digit, stable. bytes equal in all keys are skipped.
+//  in cache -> LSD, all histograms from one read
+//  larger   -> one MSD pass on the highest varying byte: per thread histograms over fixed blocks,
+//              a prefix sum over (digit, thread), every thread scatters its block to its own offsets.
+//              the buckets then fit the cache and are sorted on the threads
+//
+
+struct SortItem {
+    uint64_t Key;
+    uint32_t Index;
+};
+
+constexpr size_t SortCacheItems = size_t(1) << 16;
+
+inline void InsertionSortItems(SortItem *Items, size_t Count)
+{
+    for (size_t Next = 1; Next < Count; Next++) {
+        const SortItem Item = Items[Next];
+
+        size_t Hole = Next;
+        for (; Hole != 0 && Items[Hole - 1].Key > Item.Key; Hole--) {
+            Items[Hole] = Items[Hole - 1];
+        }
+        Items[Hole] = Item;
+    }
+}
+
+inline void LsdSortItems(SortItem *Items, SortItem *Scratch, size_t Count)
+{
+    std::array<std::array<size_t, 256>, 8> Histograms{};
+
+    uint64_t And = ~uint64_t(0), Or = 0;
+    for (size_t Index = 0; Index != Count; Index++) {
+        const uint64_t Key = Items[Index].Key;
+        for (unsigned Byte = 0; Byte != 8; Byte++) {
+            Histograms[Byte][Key >> 8 * Byte & 0xff]++;
+        }
+        And &= Key;
+        Or |= Key;
+    }
+
+    SortItem *From = Items, *To = Scratch;
+    for (unsigned Byte = 0; Byte != 8; Byte++) {
+        if (((Or ^ And) >> 8 * Byte & 0xff) == 0) {
+            continue;
+        }
+
+        auto  &Offset = Histograms[Byte];
+        size_t Sum    = 0;
+        for (auto &Digit : Offset) {
+            Sum += std::exchange(Digit, Sum);
+        }
+        for (size_t Index = 0; Index != Count; Index++) {
+            To[Offset[From[Index].Key >> 8 * Byte & 0xff]++] = From[Index];
+        }
+        std::swap(From, To);
+    }
+
+    if (From != Items) {
+        std::copy(From, From + Count, Items);
+    }
+}
+
+inline void RadixSortItems(SortItem *Items, SortItem *Scratch, size_t Count, size_t Threads)
+{
+    if (Count <= 64) {
+        InsertionSortItems(Items, Count);
+        return;
+    }
+    if (Count <= SortCacheItems) {
+        LsdSortItems(Items, Scratch, Count);
+        return;
+    }
+
+    Threads = std::max<size_t>(1, std::min(Threads, Count / SortCacheItems));
+
+    std::vector<uint64_t> Ands(Threads), Ors(Threads);
+    ParallelBlocks(Count, Threads, [&](size_t Thread, size_t Begin, size_t End) {
+        uint64_t And = ~uint64_t(0), Or = 0;
+        for (size_t Index = Begin; Index != End; Index++) {
+            And &= Items[Index].Key;
+            Or |= Items[Index].Key;
+        }
+        Ands[Thread] = And;
+        Ors[Thread]  = Or;
+    });
+
+    uint64_t And = ~uint64_t(0), Or = 0;
+    for (size_t Thread = 0; Thread != Threads; Thread++) {
+        And &= Ands[Thread];
+        Or |= Ors[Thread];
+    }
+
+    const uint64_t Varying = Or ^ And;
+    if (Varying == 0) {
+        return;
+    }
+
+    unsigned Shift = 56;
+    while ((Varying >> Shift & 0xff) == 0) {
+        Shift -= 8;
+    }
+
+    std::vector<std::array<size_t, 256>> Offsets(Threads);
+    ParallelBlocks(Count, Threads, [&](size_t Thread, size_t Begin, size_t End) {
+        auto &Histogram = Offsets[Thread];
+        Histogram.fill(0);
+        for (size_t Index = Begin; Index != End; Index++) {
+            Histogram[Items[Index].Key >> Shift & 0xff]++;
+        }
+    });
+
+    std::array<size_t, 257> Buckets;
+    size_t                  Sum = 0;
+    for (size_t Digit = 0; Digit != 256; Digit++) {
+        Buckets[Digit] = Sum;
+        for (auto &Histogram : Offsets) {
+            Sum += std::exchange(Histogram[Digit], Sum);
+        }
+    }
+    Buckets[256] = Sum;
+
+    ParallelBlocks(Count, Threads, [&](size_t Thread, size_t Begin, size_t End) {
+        auto &Offset = Offsets[Thread];
+        for (size_t Index = Begin; Index != End; Index++) {
+            Scratch[Offset[Items[Index].Key >> Shift & 0xff]++] = Items[Index];
+        }
+    });
+
+    // buckets sort in the scratch half and are copied back while still in cache
+    ParallelBlocks(256, Threads, [&](size_t, size_t Begin, size_t End) {
+        for (size_t Digit = Begin; Digit != End; Digit++) {
+            const size_t First = Buckets[Digit], Size = Buckets[Digit + 1] - First;
+            RadixSortItems(Scratch + First, Items + First, Size, 1);
+            std::copy(Scratch + First, Scratch + First + Size, Items + First);
+        }
+    });
+}
+
+//
+// MSD over chunks: runs with equal chunks and longer keys are sorted by their next chunk
+//
+
+template <size_t... _Fields, typename _Ty>
+void SortTies(const std::vector<_Ty> &Records, SortItem *Items, SortItem *Scratch, size_t Begin, size_t End,
+              size_t Chunk)
+{
+    while (Begin != End) {
+        size_t Run = Begin + 1;
+        while (Run != End && Items[Run].Key == Items[Begin].Key) {
+            Run++;
+        }
+
+        // equal prefixes have equal layouts: one record tells whether the keys go on
+        if (Run - Begin > 1 && SortKeyLength<_Fields...>(Records[Items[Begin].Index]) > 8 * Chunk) {
+            for (size_t Index = Begin; Index != Run; Index++) {
+                Items[Index].Key = SortKeyChunk<_Fields...>(Records[Items[Index].Index], Chunk);
+            }
+            RadixSortItems(Items + Begin, Scratch + Begin, Run - Begin, 1);
+            SortTies<_Fields...>(Records, Items, Scratch, Begin, Run, Chunk + 1);
+        }
+        Begin = Run;
+    }
+}
+
+template <typename _Ty, size_t... _Fields>
+std::vector<uint32_t> RadixOrderImpl(const std::vector<_Ty> &Records, size_t Threads, std::index_sequence<_Fields...>)
+{
+    static_assert(sizeof...(_Fields) != 0, "radix sort needs at least one member");
+
+    const size_t Count = Records.size();
+    if (Count > UINT32_MAX) {
+        throw std::length_error("radix sort indexes are 32 bit");
+    }
+
+    std::unique_ptr<SortItem[]> Items(new SortItem[Count]), Scratch(new SortItem[Count]);
+    ParallelBlocks(Count, Threads, [&](size_t, size_t Begin, size_t End) {
+        for (size_t Index = Begin; Index != End; Index++) {
+            Items[Index] = SortItem{SortKeyChunk<_Fields...>(Records[Index], 0), uint32_t(Index)};
+        }
+    });
+    RadixSortItems(Items.get(), Scratch.get(), Count, Threads);
+
+    if constexpr (!IsSingleChunk<_Ty, _Fields...>) {
+        // blocks are moved to run starts before any thread rewrites keys
+        const size_t        Blocks = std::max<size_t>(1, std::min(Threads, Count / SortCacheItems));
+        std::vector<size_t> Bounds(Blocks + 1, Count);
+        for (size_t Block = 0; Block != Blocks; Block++) {
+            size_t Bound = Count * Block / Blocks;
+            while (Bound != 0 && Bound != Count && Items[Bound].Key == Items[Bound - 1].Key) {
+                Bound++;
+            }
+            Bounds[Block] = Bound;
+        }
+
+        ParallelBlocks(Blocks, Blocks, [&](size_t Block, size_t, size_t) {
+            SortTies<_Fields...>(Records, Items.get(), Scratch.get(), Bounds[Block], Bounds[Block + 1], 1);
+        });
+    }
+
+    std::vector<uint32_t> Order(Count);
+    ParallelBlocks(Count, Threads, [&](size_t, size_t Begin, size_t End) {
+        for (size_t Index = Begin; Index != End; Index++) {
+            Order[Index] = Items[Index].Index;
+        }
+    });
+    return Order;
+}
+
+} // namespace DETAIL
+
+//
+// stable radix sort of records by members in visit order, RadixOrder<FieldIndex<_Ty>("Price")>.
+// members: integers, enums, floats, byte strings. no member index sorts by all members.
+//  RadixOrder -> permutation, Records[Order[0]] is the smallest record
+//  RadixSort  -> Records moved into sorted order by a gather into a second vector, sequential
+//                writes beat walking the permutation cycles in place
+//
+
+template <size_t... _Fields, typename _Ty>
+std::vector<uint32_t> RadixOrder(const std::vector<_Ty> &Records, size_t Threads)
+{
+    if constexpr (sizeof...(_Fields) == 0) {
+        return DETAIL::RadixOrderImpl(Records, Threads, std::make_index_sequence<Counts<_Ty>()>{});
+    }
+    else {
+        return DETAIL::RadixOrderImpl(Records, Threads, std::index_sequence<_Fields...>{});
+    }
+}
+
+template <size_t... _Fields, typename _Ty>
+void RadixSort(std::vector<_Ty> &Records, size_t Threads)
+{
+    const std::vector<uint32_t> Order = RadixOrder<_Fields...>(Records, Threads);
+
+    std::vector<_Ty> Sorted(Records.size());
+    DETAIL::ParallelBlocks(Records.size(), Threads, [&](size_t, size_t Begin, size_t End) {
+        for (size_t Index = Begin; Index != End; Index++) {
+            Sorted[Index] = std::move(Records[Order[Index]]);
+        }
+    });
+    Records.swap(Sorted);
+}
+
+} // namespace REFL
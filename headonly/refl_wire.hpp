@@ -0,0 +1,709 @@
+#pragma once
+
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define REFL_WIRE_SSE2 1
+#endif
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#define REFL_WIRE_BMI2 1
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define REFL_WIRE_NOINLINE __declspec(noinline)
+#else
+#define REFL_WIRE_NOINLINE __attribute__((noinline))
+#endif
+
+// the word at a time varint decoder reads little endian words
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define REFL_WIRE_SWAR 1
+#endif
+
+#include "refl_binary.hpp"
+
+namespace REFL
+{
+namespace DETAIL
+{
+
+//
+// wire kind, the low 3 bits of a tag: tag = member index << 3 | kind
+//
+
+enum class WireKind : uint8_t {
+    VARINT  = 0,
+    FIXED64 = 1,
+    LENGTH  = 2,
+    FIXED32 = 5,
+};
+
+template <typename _Ty>
+constexpr WireKind GetWireKind()
+{
+    if constexpr (std::is_integral_v<_Ty> || std::is_enum_v<_Ty>) {
+        return WireKind::VARINT;
+    }
+    else if constexpr (std::is_same_v<_Ty, float>) {
+        return WireKind::FIXED32;
+    }
+    else if constexpr (std::is_same_v<_Ty, double>) {
+        return WireKind::FIXED64;
+    }
+    else if constexpr (IsStringType<_Ty> || IsContainerType<_Ty> || std::is_array_v<_Ty> || std::is_class_v<_Ty>) {
+        return WireKind::LENGTH;
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be wire encoded");
+    }
+}
+
+template <typename _Ty>
+constexpr bool IsWireFixed = GetWireKind<_Ty>() == WireKind::FIXED32 || GetWireKind<_Ty>() == WireKind::FIXED64;
+
+template <typename _Ty, size_t _I>
+constexpr uint64_t WireTag = uint64_t(_I) << 3 | uint64_t(GetWireKind<_Ty>());
+
+//
+// fixed size containers are filled in place, sets are rebuilt by insert
+//
+
+template <typename _Ty, typename = void>
+struct IsInsertableImpl : std::false_type {
+};
+
+template <typename _Ty>
+struct IsInsertableImpl<_Ty, std::void_t<decltype(std::declval<_Ty &>().insert(std::declval<_Ty &>().end(),
+                                                                                std::declval<ElementType<_Ty>>()))>>
+    : std::true_type {
+};
+
+//
+// bit scans, Value != 0
+//
+
+inline unsigned TrailingZeros64(uint64_t Value)
+{
+#if defined(_MSC_VER)
+    unsigned long Index;
+    _BitScanForward64(&Index, Value);
+    return unsigned(Index);
+#else
+    return unsigned(__builtin_ctzll(Value));
+#endif
+}
+
+inline unsigned LeadingZeros64(uint64_t Value)
+{
+#if defined(_MSC_VER)
+    unsigned long Index;
+    _BitScanReverse64(&Index, Value);
+    return 63 - unsigned(Index);
+#else
+    return unsigned(__builtin_clzll(Value));
+#endif
+}
+
+//
+// LEB128: 7 bits per byte, low group first, the high bit marks a following byte.
+// signed values are zigzag mapped first: 0, -1, 1, -2 ... -> 0, 1, 2, 3 ...
+//
+
+template <typename _Ty>
+uint64_t ToVarint(_Ty Value)
+{
+    if constexpr (std::is_enum_v<_Ty>) {
+        return ToVarint(std::underlying_type_t<_Ty>(Value));
+    }
+    else if constexpr (std::is_signed_v<_Ty>) {
+        return uint64_t(int64_t(Value)) << 1 ^ uint64_t(int64_t(Value) >> 63);
+    }
+    else {
+        return uint64_t(Value);
+    }
+}
+
+template <typename _Ty>
+_Ty FromVarint(uint64_t Value)
+{
+    if constexpr (std::is_enum_v<_Ty>) {
+        return _Ty(FromVarint<std::underlying_type_t<_Ty>>(Value));
+    }
+    else if constexpr (std::is_signed_v<_Ty>) {
+        return _Ty(int64_t(Value >> 1) ^ -int64_t(Value & 1));
+    }
+    else {
+        return _Ty(Value);
+    }
+}
+
+// 1 + floor(log2(Value)) / 7 without a loop
+inline size_t VarintSize(uint64_t Value)
+{
+    return (size_t(63 - LeadingZeros64(Value | 1)) * 9 + 73) / 64;
+}
+
+constexpr size_t WireTagSize(uint64_t Tag)
+{
+    size_t Size = 1;
+    for (; Tag >= 0x80; Tag >>= 7) {
+        Size++;
+    }
+    return Size;
+}
+
+inline void WriteVarint(char *&Cursor, uint64_t Value)
+{
+    for (; Value >= 0x80; Value >>= 7) {
+        *Cursor++ = char(Value | 0x80);
+    }
+    *Cursor++ = char(Value);
+}
+
+// packs the 7 bit groups of up to 8 varint bytes, continuation bits included in Bytes
+inline uint64_t VarintCompact(uint64_t Bytes)
+{
+#if defined(REFL_WIRE_BMI2)
+    return _pext_u64(Bytes, 0x7f7f7f7f7f7f7f7full);
+#else
+    Bytes &= 0x7f7f7f7f7f7f7f7full;
+    Bytes = (Bytes & 0x007f007f007f007full) | (Bytes & 0x7f007f007f007f00ull) >> 1;
+    Bytes = (Bytes & 0x00003fff00003fffull) | (Bytes & 0x3fff00003fff0000ull) >> 2;
+    return (Bytes & 0x000000000fffffffull) | (Bytes & 0x0fffffff00000000ull) >> 4;
+#endif
+}
+
+// one item per byte without continuation bit, 16 bytes per step with SSE2
+inline size_t CountVarints(const char *Data, size_t Size)
+{
+    size_t Count = 0;
+    size_t Index = 0;
+#if defined(REFL_WIRE_SSE2)
+    for (; Index + 16 <= Size; Index += 16) {
+        const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Data + Index));
+        Count += 16 - std::bitset<16>(unsigned(_mm_movemask_epi8(Bytes))).count();
+    }
+#endif
+    for (; Index != Size; Index++) {
+        Count += uint8_t(Data[Index]) < 0x80;
+    }
+    return Count;
+}
+
+//
+// encoded size. lengths of nested payloads are computed again when they are written,
+// once per nesting level.
+//
+
+template <typename _Ty>
+size_t WirePayloadSize(const _Ty &Object);
+
+template <typename _Ty>
+size_t WireValueSize(const _Ty &Object)
+{
+    constexpr WireKind Kind = GetWireKind<_Ty>();
+
+    if constexpr (Kind == WireKind::VARINT) {
+        return VarintSize(ToVarint(Object));
+    }
+    else if constexpr (IsWireFixed<_Ty>) {
+        return sizeof(_Ty);
+    }
+    else {
+        const size_t Payload = WirePayloadSize(Object);
+        return VarintSize(Payload) + Payload;
+    }
+}
+
+template <size_t... _I, typename... _Members>
+size_t WireFieldsSize(std::index_sequence<_I...>, const _Members &...Members)
+{
+    return (size_t(0) + ... + (WireTagSize(WireTag<_Members, _I>) + WireValueSize(Members)));
+}
+
+template <typename _Ty>
+size_t WirePayloadSize(const _Ty &Object)
+{
+    if constexpr (IsStringType<_Ty>) {
+        return Object.length() * sizeof(typename _Ty::value_type);
+    }
+    else if constexpr (IsMapType<_Ty>) {
+        size_t Size = 0;
+        for (auto &&[Key, Value] : Object) {
+            Size += WireValueSize(Key) + WireValueSize(Value);
+        }
+        return Size;
+    }
+    else if constexpr (IsContainerType<_Ty> || std::is_array_v<_Ty>) {
+        using Element = ElementType<_Ty>;
+
+        if constexpr (IsWireFixed<Element>) {
+            return std::size(Object) * sizeof(Element);
+        }
+        else {
+            size_t Size = 0;
+            for (auto &&Item : Object) {
+                Size += WireValueSize(Item);
+            }
+            return Size;
+        }
+    }
+    else if constexpr (std::is_class_v<_Ty>) {
+        return Visits(Object, [](auto &...Members) {
+            return WireFieldsSize(std::index_sequence_for<decltype(Members)...>{}, Members...);
+        });
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be wire encoded");
+    }
+}
+
+//
+// writer, the buffer is sized up front
+//
+
+template <typename _Ty>
+void WirePayloadWrite(const _Ty &Object, char *&Cursor);
+
+template <typename _Ty>
+void WireValueWrite(const _Ty &Object, char *&Cursor)
+{
+    constexpr WireKind Kind = GetWireKind<_Ty>();
+
+    if constexpr (Kind == WireKind::VARINT) {
+        WriteVarint(Cursor, ToVarint(Object));
+    }
+    else if constexpr (IsWireFixed<_Ty>) {
+        WriteRaw(Cursor, &Object, sizeof(_Ty));
+    }
+    else {
+        WriteVarint(Cursor, WirePayloadSize(Object));
+        WirePayloadWrite(Object, Cursor);
+    }
+}
+
+template <size_t... _I, typename... _Members>
+void WireFieldsWrite(char *&Cursor, std::index_sequence<_I...>, const _Members &...Members)
+{
+    ((WriteVarint(Cursor, WireTag<_Members, _I>), WireValueWrite(Members, Cursor)), ...);
+}
+
+template <typename _Ty>
+void WirePayloadWrite(const _Ty &Object, char *&Cursor)
+{
+    if constexpr (IsStringType<_Ty>) {
+        WriteRaw(Cursor, Object.data(), Object.length() * sizeof(typename _Ty::value_type));
+    }
+    else if constexpr (IsMapType<_Ty>) {
+        for (auto &&[Key, Value] : Object) {
+            WireValueWrite(Key, Cursor);
+            WireValueWrite(Value, Cursor);
+        }
+    }
+    else if constexpr (IsContainerType<_Ty> || std::is_array_v<_Ty>) {
+        using Element = ElementType<_Ty>;
+
+        if constexpr (IsWireFixed<Element> && (IsContiguousImpl<_Ty>::value || std::is_array_v<_Ty>)) {
+            WriteRaw(Cursor, std::data(Object), std::size(Object) * sizeof(Element));
+        }
+        else {
+            for (auto &&Item : Object) {
+                WireValueWrite(Item, Cursor);
+            }
+        }
+    }
+    else if constexpr (std::is_class_v<_Ty>) {
+        Visits(Object, [&](auto &...Members) {
+            WireFieldsWrite(Cursor, std::index_sequence_for<decltype(Members)...>{}, Members...);
+        });
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be wire encoded");
+    }
+}
+
+//
+// reader, bounds checked. a length delimited payload gets its own reader, so skipping
+// any field costs at most one varint.
+//
+
+struct WireReader {
+    const char *Cursor;
+    const char *End;
+    const char *Limit; // end of the whole input: word loads may cross End, values may not
+
+    WireReader(const char *Begin, const char *End) : WireReader(Begin, End, End) {}
+    WireReader(const char *Begin, const char *End, const char *Limit) : Cursor(Begin), End(End), Limit(Limit) {}
+
+    bool Empty() const { return Cursor == End; }
+
+    void Require(size_t Size) const
+    {
+        if (size_t(End - Cursor) < Size) {
+            throw std::out_of_range("wire input truncated");
+        }
+    }
+
+    void Raw(void *Data, size_t Size)
+    {
+        Require(Size);
+        std::memcpy(Data, Cursor, Size);
+        Cursor += Size;
+    }
+
+    // one byte values return at once: every member has its own inlined copy, so the branch
+    // learns that member's usual size. up to 8 bytes (values below 2^56) come from one load,
+    // the lowest clear high bit ends the varint. longer ones and the input tail go bytewise.
+    uint64_t Varint()
+    {
+#if defined(REFL_WIRE_SWAR)
+        if (size_t(Limit - Cursor) >= sizeof(uint64_t) && Cursor != End) {
+            if (uint8_t(*Cursor) < 0x80) {
+                return uint8_t(*Cursor++);
+            }
+
+            uint64_t Word;
+            std::memcpy(&Word, Cursor, sizeof(Word));
+
+            const uint64_t Stops  = ~Word & 0x8080808080808080ull;
+            const size_t   Length = (TrailingZeros64(Stops | 1ull << 63) + 1) / 8;
+            if (Stops != 0 && Length <= size_t(End - Cursor)) {
+                Cursor += Length;
+                return VarintCompact(Word & (Stops ^ (Stops - 1)));
+            }
+        }
+#endif
+        return VarintBytewise();
+    }
+
+    // out of line, Varint stays small enough to inline
+    REFL_WIRE_NOINLINE uint64_t VarintBytewise()
+    {
+        uint64_t Value = 0;
+        for (unsigned Shift = 0; Shift < 64; Shift += 7) {
+            Require(1);
+            const uint8_t Byte = uint8_t(*Cursor++);
+            Value |= uint64_t(Byte & 0x7f) << Shift;
+            if (Byte < 0x80) {
+                return Value;
+            }
+        }
+        throw std::out_of_range("wire varint too long");
+    }
+
+    WireReader Payload()
+    {
+        const uint64_t Length = Varint();
+        if (Length > uint64_t(End - Cursor)) {
+            throw std::out_of_range("wire input truncated");
+        }
+
+        const WireReader Inner{Cursor, Cursor + Length, Limit};
+        Cursor += Length;
+        return Inner;
+    }
+
+    void Skip(uint64_t Tag)
+    {
+        switch (WireKind(Tag & 7)) {
+        case WireKind::VARINT:
+            Varint();
+            break;
+        case WireKind::FIXED64:
+            Require(8);
+            Cursor += 8;
+            break;
+        case WireKind::LENGTH:
+            Payload();
+            break;
+        case WireKind::FIXED32:
+            Require(4);
+            Cursor += 4;
+            break;
+        default:
+            throw std::out_of_range("wire kind unknown");
+        }
+    }
+};
+
+// items in a packed payload: varints by their last bytes, fixed by size, others by skipping
+template <typename _Element>
+size_t WireItemCount(const WireReader &Reader)
+{
+    constexpr WireKind Kind = GetWireKind<_Element>();
+
+    const size_t Size = size_t(Reader.End - Reader.Cursor);
+    if constexpr (Kind == WireKind::VARINT) {
+        return CountVarints(Reader.Cursor, Size);
+    }
+    else if constexpr (IsWireFixed<_Element>) {
+        if (Size % sizeof(_Element) != 0) {
+            throw std::out_of_range("wire packed size mismatch");
+        }
+        return Size / sizeof(_Element);
+    }
+    else {
+        size_t     Count = 0;
+        WireReader Scan  = Reader;
+        for (; !Scan.Empty(); Count++) {
+            Scan.Payload();
+        }
+        return Count;
+    }
+}
+
+// packed varints into an array. SSE2 finds the one byte values before the first continuation
+// bit; all 16 bytes are widened, a fixed trip count that vectorizes, and the lanes past the
+// run are written again by the following steps.
+template <typename _Element>
+void WireVarintsRead(_Element *Items, size_t Count, WireReader &Reader)
+{
+    size_t Index = 0;
+#if defined(REFL_WIRE_SSE2)
+    while (Count - Index >= 16 && size_t(Reader.End - Reader.Cursor) >= 16) {
+        const __m128i  Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(Reader.Cursor));
+        const unsigned Run   = TrailingZeros64(unsigned(_mm_movemask_epi8(Bytes)) | 1u << 16);
+
+        for (size_t Lane = 0; Lane != 16; Lane++) {
+            Items[Index + Lane] = FromVarint<_Element>(uint8_t(Reader.Cursor[Lane]));
+        }
+        Index += Run;
+        Reader.Cursor += Run;
+
+        if (Run != 16) {
+            Items[Index++] = FromVarint<_Element>(Reader.Varint());
+        }
+    }
+#endif
+    for (; Index != Count; Index++) {
+        Items[Index] = FromVarint<_Element>(Reader.Varint());
+    }
+}
+
+template <typename _Ty>
+void WirePayloadRead(_Ty &Object, WireReader &Reader);
+
+template <typename _Ty>
+void WireValueRead(_Ty &Object, WireReader &Reader)
+{
+    constexpr WireKind Kind = GetWireKind<_Ty>();
+
+    if constexpr (Kind == WireKind::VARINT) {
+        Object = FromVarint<_Ty>(Reader.Varint());
+    }
+    else if constexpr (IsWireFixed<_Ty>) {
+        Reader.Raw(&Object, sizeof(_Ty));
+    }
+    else {
+        WireReader Payload = Reader.Payload();
+        WirePayloadRead(Object, Payload);
+    }
+}
+
+//
+// fields: writer order is tried first, one compare per member and no dispatch.
+// anything else (reordered, missing, unknown index, changed kind) goes through a table.
+//
+
+template <size_t _I, typename _Ty>
+bool WireFieldTryRead(_Ty &Member, WireReader &Reader)
+{
+    constexpr uint64_t Tag = WireTag<_Ty, _I>;
+
+    if constexpr (Tag < 0x80) {
+        if (Reader.Empty() || uint8_t(*Reader.Cursor) != Tag) {
+            return false;
+        }
+        Reader.Cursor++;
+    }
+    else {
+        WireReader Peek = Reader;
+        if (Reader.Empty() || Peek.Varint() != Tag) {
+            return false;
+        }
+        Reader.Cursor = Peek.Cursor;
+    }
+
+    WireValueRead(Member, Reader);
+    return true;
+}
+
+template <typename _Ty>
+void WireSlotRead(void *Member, WireReader &Reader)
+{
+    WireValueRead(*static_cast<_Ty *>(Member), Reader);
+}
+
+struct WireSlot {
+    void    *Member;
+    void     (*Read)(void *, WireReader &);
+    uint64_t Kind;
+};
+
+template <size_t... _I, typename... _Members>
+void WireFieldsRead(WireReader &Reader, std::index_sequence<_I...>, _Members &...Members)
+{
+    if constexpr (sizeof...(_Members) != 0) {
+        bool InOrder = true;
+        ((InOrder = InOrder && WireFieldTryRead<_I>(Members, Reader)), ...);
+
+        if (Reader.Empty()) {
+            return;
+        }
+
+        const WireSlot Slots[] = {{&Members, &WireSlotRead<_Members>, uint64_t(GetWireKind<_Members>())}...};
+        while (!Reader.Empty()) {
+            const uint64_t Tag   = Reader.Varint();
+            const uint64_t Index = Tag >> 3;
+            if (Index < sizeof...(_Members) && (Tag & 7) == Slots[Index].Kind) {
+                Slots[Index].Read(Slots[Index].Member, Reader);
+            }
+            else {
+                Reader.Skip(Tag);
+            }
+        }
+    }
+    else {
+        while (!Reader.Empty()) {
+            Reader.Skip(Reader.Varint());
+        }
+    }
+}
+
+template <typename _Ty>
+void WirePayloadRead(_Ty &Object, WireReader &Reader)
+{
+    if constexpr (IsStringType<_Ty>) {
+        using Char = typename _Ty::value_type;
+
+        const size_t Size = size_t(Reader.End - Reader.Cursor);
+        if (Size % sizeof(Char) != 0) {
+            throw std::out_of_range("wire string size mismatch");
+        }
+        Object.resize(Size / sizeof(Char));
+        Reader.Raw(Object.data(), Size);
+    }
+    else if constexpr (IsMapType<_Ty>) {
+        Object.clear();
+        while (!Reader.Empty()) {
+            typename _Ty::key_type    Key{};
+            typename _Ty::mapped_type Value{};
+            WireValueRead(Key, Reader);
+            WireValueRead(Value, Reader);
+            Object.emplace(std::move(Key), std::move(Value));
+        }
+    }
+    else if constexpr (IsContainerType<_Ty> || std::is_array_v<_Ty>) {
+        using Element = ElementType<_Ty>;
+
+        if constexpr (IsWireFixed<Element> && IsContiguousImpl<_Ty>::value && IsResizableImpl<_Ty>::value) {
+            Object.resize(WireItemCount<Element>(Reader));
+            Reader.Raw(std::data(Object), std::size(Object) * sizeof(Element));
+        }
+        else if constexpr (GetWireKind<Element>() == WireKind::VARINT && IsContiguousImpl<_Ty>::value &&
+                           IsResizableImpl<_Ty>::value) {
+            Object.resize(WireItemCount<Element>(Reader));
+            WireVarintsRead(std::data(Object), std::size(Object), Reader);
+            if (!Reader.Empty()) {
+                throw std::out_of_range("wire packed size mismatch");
+            }
+        }
+        else if constexpr (IsResizableImpl<_Ty>::value) {
+            // existing items are reused: strings and vectors keep their capacity
+            Object.resize(WireItemCount<Element>(Reader));
+            for (auto &&Item : Object) {
+                WireValueRead(Item, Reader);
+            }
+            if (!Reader.Empty()) {
+                throw std::out_of_range("wire packed size mismatch");
+            }
+        }
+        else if constexpr (IsInsertableImpl<_Ty>::value) {
+            Object.clear();
+            while (!Reader.Empty()) {
+                Element Item{};
+                WireValueRead(Item, Reader);
+                Object.insert(Object.end(), std::move(Item));
+            }
+        }
+        else {
+            // fixed extent: items beyond it are dropped, missing ones keep their value
+            for (auto &&Item : Object) {
+                if (Reader.Empty()) {
+                    break;
+                }
+                WireValueRead(Item, Reader);
+            }
+        }
+    }
+    else if constexpr (std::is_class_v<_Ty>) {
+        Visits(Object, [&](auto &...Members) {
+            WireFieldsRead(Reader, std::index_sequence_for<decltype(Members)...>{}, Members...);
+        });
+    }
+    else {
+        static_assert(AlwaysFalse<_Ty>, "type can not be wire decoded");
+    }
+}
+
+} // namespace DETAIL
+
+//
+// compact tagged encoding, a message is the fields of a class: varint tag (member index << 3 | kind) + value.
+//  integer, enum, bool           -> LEB128 varint, signed zigzag
+//  float, double                 -> 4 / 8 bytes, host byte order
+//  string, container, map, class -> varint byte length + payload, scalar items packed
+// decoding skips unknown member indexes and changed kinds, members not on the wire keep their value.
+//
+
+template <typename _Ty>
+size_t WireSize(const _Ty &Object)
+{
+    static_assert(DETAIL::GetWireKind<_Ty>() == DETAIL::WireKind::LENGTH, "wire message needs a class or container");
+
+    return DETAIL::WirePayloadSize(Object);
+}
+
+// Buffer must hold WireSize(Object) bytes, returns the bytes written
+template <typename _Ty>
+size_t WireWrite(const _Ty &Object, void *Buffer)
+{
+    char *Cursor = static_cast<char *>(Buffer);
+    DETAIL::WirePayloadWrite(Object, Cursor);
+    return size_t(Cursor - static_cast<char *>(Buffer));
+}
+
+// the message is all of [Buffer, Buffer + Size), throws std::out_of_range on malformed input
+template <typename _Ty>
+void WireRead(_Ty &Object, const void *Buffer, size_t Size)
+{
+    static_assert(DETAIL::GetWireKind<_Ty>() == DETAIL::WireKind::LENGTH, "wire message needs a class or container");
+
+    DETAIL::WireReader Reader{static_cast<const char *>(Buffer), static_cast<const char *>(Buffer) + Size};
+    DETAIL::WirePayloadRead(Object, Reader);
+}
+
+template <typename _Ty, typename _Buffer>
+void WireEncode(const _Ty &Object, _Buffer &Buffer)
+{
+    Buffer.resize(WireSize(Object));
+    WireWrite(Object, Buffer.data());
+}
+
+template <typename _Ty, typename _Buffer>
+void WireDecode(_Ty &Object, const _Buffer &Buffer)
+{
+    WireRead(Object, Buffer.data(), Buffer.size());
+}
+
+} // namespace REFL
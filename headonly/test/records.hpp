@@ -0,0 +1,64 @@
+/*********************************************************************
+ * \file   records.hpp
+ * \brief  the order record and generators the reflection tests share
+ *         deterministic, so round trips and benchmarks see the same data
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <refl.hpp>
+
+namespace RECORDS
+{
+
+// 5000 distinct symbols, short enough for the small string buffer
+inline std::string Symbol(size_t Index)
+{
+    return "SYM" + std::to_string(Index % 5000);
+}
+
+// quarter ticks from 100
+inline double Price(size_t Index)
+{
+    return 100.0 + double(Index % 1000) * 0.25;
+}
+
+class Order
+{
+public:
+    uint64_t              Id       = 0;
+    std::string           Symbol;
+    double                Price    = 0;
+    uint32_t              Quantity = 0;
+    bool                  Buy      = false;
+    std::vector<uint32_t> Tags;
+    std::string           Note;
+
+    MAKE_REFL(Order, Id, Symbol, Price, Quantity, Buy, Tags, Note);
+};
+
+// every 16th note needs json escapes
+inline std::vector<Order> MakeOrders(size_t Count)
+{
+    std::vector<Order> Orders(Count);
+    for (size_t Index = 0; Index != Count; Index++) {
+        auto &Order    = Orders[Index];
+        Order.Id       = Index;
+        Order.Symbol   = Symbol(Index);
+        Order.Price    = Price(Index);
+        Order.Quantity = uint32_t(Index % 700);
+        Order.Buy      = Index % 2 == 0;
+        Order.Tags.assign(Index % 4, uint32_t(Index));
+        Order.Note = Index % 16 == 0 ? "client said \"fill or kill\"\n\tdesk 4" : "regular order from the api gateway";
+    }
+    return Orders;
+}
+
+} // namespace RECORDS
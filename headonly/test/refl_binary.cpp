@@ -0,0 +1,313 @@
+/*********************************************************************
+ * \file   refl_binary.cpp
+ * \brief  reflection driven binary serialization
+ *         round trips and 1M records against hand-written code
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/stopwatch.h>
+
+#include <array>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <refl_binary.hpp>
+
+#include "records.hpp"
+
+namespace
+{
+
+struct Tick {
+    uint64_t Id;
+    double   Price;
+    uint32_t Quantity;
+    uint32_t Side;
+};
+
+struct Padded {
+    uint8_t  Flag;
+    uint64_t Value;
+};
+
+using RECORDS::MakeOrders;
+using RECORDS::Order;
+
+class Book
+{
+public:
+    std::string                     Venue;
+    std::vector<Order>              Orders;
+    std::map<std::string, uint32_t> Limits;
+    std::vector<Tick>               Ticks;
+    Padded                          Last;
+
+    MAKE_REFL(Book, Venue, Orders, Limits, Ticks, Last);
+};
+
+// std::array members: raw bytes when the elements allow it, element by element otherwise
+struct Quote {
+    std::array<uint32_t, 4> Sizes;
+    uint64_t                Id;
+};
+
+class Levels
+{
+public:
+    std::array<int32_t, 4>     Depth{};
+    int32_t                    Count = 0;
+    std::array<std::string, 2> Names;
+    Quote                      Best{};
+
+    MAKE_REFL(Levels, Depth, Count, Names, Best);
+};
+
+static_assert(REFL::IsPaddingFree<Tick>);
+static_assert(REFL::IsPaddingFree<Quote>);
+static_assert(!REFL::IsPaddingFree<Levels>);
+static_assert(!REFL::IsPaddingFree<Padded>);
+static_assert(!REFL::IsPaddingFree<Order>);
+
+//
+// the hand-written serializer this replaces
+//
+
+size_t HandSize(const std::vector<Order> &Orders)
+{
+    size_t Size = sizeof(uint32_t);
+    for (auto &Order : Orders) {
+        Size += sizeof(Order.Id) + sizeof(uint32_t) + Order.Symbol.size() + sizeof(Order.Price) +
+                sizeof(Order.Quantity) + sizeof(Order.Buy) + sizeof(uint32_t) + Order.Tags.size() * sizeof(uint32_t) +
+                sizeof(uint32_t) + Order.Note.size();
+    }
+    return Size;
+}
+
+void HandWrite(const std::vector<Order> &Orders, char *Cursor)
+{
+    auto Raw = [&](const void *Data, size_t Size) {
+        std::memcpy(Cursor, Data, Size);
+        Cursor += Size;
+    };
+
+    const uint32_t Count = uint32_t(Orders.size());
+    Raw(&Count, sizeof(Count));
+
+    for (auto &Order : Orders) {
+        const uint32_t SymbolLength = uint32_t(Order.Symbol.size());
+        const uint32_t TagCount     = uint32_t(Order.Tags.size());
+        const uint32_t NoteLength   = uint32_t(Order.Note.size());
+
+        Raw(&Order.Id, sizeof(Order.Id));
+        Raw(&SymbolLength, sizeof(SymbolLength));
+        Raw(Order.Symbol.data(), SymbolLength);
+        Raw(&Order.Price, sizeof(Order.Price));
+        Raw(&Order.Quantity, sizeof(Order.Quantity));
+        Raw(&Order.Buy, sizeof(Order.Buy));
+        Raw(&TagCount, sizeof(TagCount));
+        Raw(Order.Tags.data(), TagCount * sizeof(uint32_t));
+        Raw(&NoteLength, sizeof(NoteLength));
+        Raw(Order.Note.data(), NoteLength);
+    }
+}
+
+void HandRead(std::vector<Order> &Orders, const char *Cursor)
+{
+    auto Raw = [&](void *Data, size_t Size) {
+        std::memcpy(Data, Cursor, Size);
+        Cursor += Size;
+    };
+
+    uint32_t Count;
+    Raw(&Count, sizeof(Count));
+    Orders.resize(Count);
+
+    for (auto &Order : Orders) {
+        uint32_t SymbolLength, TagCount, NoteLength;
+
+        Raw(&Order.Id, sizeof(Order.Id));
+        Raw(&SymbolLength, sizeof(SymbolLength));
+        Order.Symbol.resize(SymbolLength);
+        Raw(Order.Symbol.data(), SymbolLength);
+        Raw(&Order.Price, sizeof(Order.Price));
+        Raw(&Order.Quantity, sizeof(Order.Quantity));
+        Raw(&Order.Buy, sizeof(Order.Buy));
+        Raw(&TagCount, sizeof(TagCount));
+        Order.Tags.resize(TagCount);
+        Raw(Order.Tags.data(), TagCount * sizeof(uint32_t));
+        Raw(&NoteLength, sizeof(NoteLength));
+        Order.Note.resize(NoteLength);
+        Raw(Order.Note.data(), NoteLength);
+    }
+}
+
+} // namespace
+
+TEST_CASE("refl_binary_round_trip")
+{
+    spdlog::info("--- --- --- refl_binary_round_trip --- --- ---");
+
+    Book Source;
+    Source.Venue  = "XNAS";
+    Source.Orders = MakeOrders(10);
+    Source.Limits = {{"AAPL", 100}, {"MSFT", 250}};
+    Source.Ticks  = {{1, 10.5, 3, 0}, {2, 11.5, 4, 1}};
+    Source.Last   = {7, 42};
+
+    std::vector<char> Buffer;
+    REFL::Serialize(Source, Buffer);
+    CHECK(Buffer.size() == REFL::BinarySize(Source));
+
+    Book Target;
+    REFL::Deserialize(Target, Buffer);
+
+    CHECK(Target.Venue == Source.Venue);
+    CHECK(Target.Limits == Source.Limits);
+    CHECK(Target.Last.Flag == 7);
+    CHECK(Target.Last.Value == 42);
+    REQUIRE(Target.Orders.size() == Source.Orders.size());
+    CHECK(Target.Orders[3].Symbol == "SYM3");
+    CHECK(Target.Orders[3].Tags == Source.Orders[3].Tags);
+    REQUIRE(Target.Ticks.size() == 2);
+    CHECK(std::memcmp(Target.Ticks.data(), Source.Ticks.data(), 2 * sizeof(Tick)) == 0);
+
+    // truncated input is rejected, not read past the end
+    bool Thrown = false;
+    try {
+        REFL::BinaryRead(Target, Buffer.data(), Buffer.size() - 1);
+    }
+    catch (const std::out_of_range &) {
+        Thrown = true;
+    }
+    CHECK(Thrown);
+
+    // a count the input can not hold is rejected the same way, not allocated
+    const uint32_t Huge = 0xffffffff;
+    std::vector<std::string> Strings;
+    Thrown = false;
+    try {
+        REFL::BinaryRead(Strings, &Huge, sizeof(Huge));
+    }
+    catch (const std::out_of_range &) {
+        Thrown = true;
+    }
+    CHECK(Thrown);
+    CHECK(Strings.empty());
+
+    std::map<std::string, int32_t> Names;
+    Thrown = false;
+    try {
+        REFL::BinaryRead(Names, &Huge, sizeof(Huge));
+    }
+    catch (const std::out_of_range &) {
+        Thrown = true;
+    }
+    CHECK(Thrown);
+
+    // items of no bytes can not be bounded by the input: the count is capped
+    struct Empty {
+    };
+    std::vector<Empty> Empties(3);
+    Buffer.clear();
+    REFL::Serialize(Empties, Buffer);
+    REQUIRE(Buffer.size() == sizeof(uint32_t));
+    Empties.clear();
+    REFL::BinaryRead(Empties, Buffer.data(), Buffer.size());
+    CHECK(Empties.size() == 3);
+
+    Thrown = false;
+    try {
+        REFL::BinaryRead(Empties, &Huge, sizeof(Huge));
+    }
+    catch (const std::out_of_range &) {
+        Thrown = true;
+    }
+    CHECK(Thrown);
+}
+
+TEST_CASE("refl_binary_std_array")
+{
+    spdlog::info("--- --- --- refl_binary_std_array --- --- ---");
+
+    Levels Source;
+    Source.Depth = {1, -2, 3, -4};
+    Source.Count = 4;
+    Source.Names = {"bid", "ask"};
+    Source.Best  = {{10, 20, 30, 40}, 99};
+
+    std::vector<char> Buffer;
+    REFL::Serialize(Source, Buffer);
+    CHECK(Buffer.size() == REFL::BinarySize(Source));
+
+    Levels Target;
+    REFL::Deserialize(Target, Buffer);
+
+    CHECK(Target.Depth == Source.Depth);
+    CHECK(Target.Count == 4);
+    CHECK(Target.Names == Source.Names);
+    CHECK(Target.Best.Sizes == Source.Best.Sizes);
+    CHECK(Target.Best.Id == 99);
+}
+
+TEST_CASE("refl_binary_benchmark")
+{
+    spdlog::info("--- --- --- refl_binary_benchmark --- --- ---");
+
+    const size_t Count = 1UL << 20;
+
+    // padding free records collapse to one memcpy
+    std::vector<Tick> Ticks(Count, Tick{1, 2.0, 3, 4});
+    std::vector<char> TickBuffer;
+    {
+        spdlog::stopwatch Watch;
+        REFL::Serialize(Ticks, TickBuffer);
+        spdlog::info("refl serialize ticks:   {:.4f}s, {} bytes", Watch, TickBuffer.size());
+    }
+
+    const auto         Orders = MakeOrders(Count);
+    std::vector<char>  Buffer;
+    std::vector<Order> Target;
+
+    {
+        spdlog::stopwatch Watch;
+        Buffer.resize(HandSize(Orders));
+        HandWrite(Orders, Buffer.data());
+        spdlog::info("hand serialize orders:   {:.4f}s, {} bytes", Watch, Buffer.size());
+    }
+    {
+        spdlog::stopwatch Watch;
+        HandRead(Target, Buffer.data());
+        spdlog::info("hand deserialize orders: {:.4f}s", Watch);
+    }
+
+    std::vector<char> ReflBuffer;
+    {
+        spdlog::stopwatch Watch;
+        REFL::Serialize(Orders, ReflBuffer);
+        spdlog::info("refl serialize orders:   {:.4f}s, {} bytes", Watch, ReflBuffer.size());
+    }
+
+    // the sized buffer is reused: the write path allocates nothing
+    {
+        spdlog::stopwatch Watch;
+        REFL::BinaryWrite(Orders, ReflBuffer.data());
+        spdlog::info("refl rewrite orders:     {:.4f}s", Watch);
+    }
+    {
+        std::vector<Order>().swap(Target);
+
+        spdlog::stopwatch Watch;
+        REFL::Deserialize(Target, ReflBuffer);
+        spdlog::info("refl deserialize orders: {:.4f}s", Watch);
+    }
+
+    // same layout as the hand-written format
+    CHECK(ReflBuffer == Buffer);
+    CHECK(Target.back().Symbol == Orders.back().Symbol);
+}
@@ -0,0 +1,137 @@
+/*********************************************************************
+ * \file   refl_bulk.cpp
+ * \brief  two phase parallel serialization of record vectors
+ *         records/s and GB/s from one thread to all hardware threads
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/stopwatch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <refl_bulk.hpp>
+
+#include "records.hpp"
+
+namespace
+{
+
+using RECORDS::MakeOrders;
+using RECORDS::Order;
+
+} // namespace
+
+TEST_CASE("refl_bulk_round_trip")
+{
+    spdlog::info("--- --- --- refl_bulk_round_trip --- --- ---");
+
+    const std::vector<Order> Source = MakeOrders(1001);
+
+    // same bytes for any thread count, records in the plain binary format
+    std::string Single, Multi;
+    REFL::BulkSerialize(Source, Single, 1);
+    REFL::BulkSerialize(Source, Multi, 7);
+    CHECK(Single == Multi);
+
+    std::string Plain;
+    REFL::Serialize(Source[500], Plain);
+    uint64_t Offset = 0;
+    std::memcpy(&Offset, Multi.data() + (500 + 1) * sizeof(uint64_t), sizeof(Offset));
+    CHECK(Multi.compare(REFL::DETAIL::BulkIndexSize(Source.size()) + Offset, Plain.size(), Plain) == 0);
+
+    std::vector<Order> Target;
+    REFL::BulkDeserialize(Target, Multi, 4);
+    REQUIRE(Target.size() == Source.size());
+    CHECK(Target[1000].Symbol == Source[1000].Symbol);
+    CHECK(Target[999].Tags == Source[999].Tags);
+    CHECK(Target[3].Note == Source[3].Note);
+
+    // more threads than records, no records
+    REFL::BulkSerialize(std::vector<Order>(Source.begin(), Source.begin() + 2), Multi, 16);
+    REFL::BulkDeserialize(Target, Multi, 16);
+    CHECK(Target.size() == 2);
+
+    REFL::BulkSerialize(std::vector<Order>{}, Multi, 4);
+    CHECK(Multi.size() == REFL::DETAIL::BulkIndexSize(0));
+    REFL::BulkDeserialize(Target, Multi, 4);
+    CHECK(Target.empty());
+
+    // damaged input is reported from the worker threads
+    REFL::BulkSerialize(Source, Multi, 4);
+    bool Thrown = false;
+    try {
+        REFL::BulkDeserialize(Target, Multi.data(), Multi.size() - 1, 4);
+    }
+    catch (const std::out_of_range &) {
+        Thrown = true;
+    }
+    CHECK(Thrown);
+}
+
+TEST_CASE("refl_bulk_benchmark")
+{
+    spdlog::info("--- --- --- refl_bulk_benchmark --- --- ---");
+
+    const size_t            Count  = 1UL << 21;
+    const std::vector<Order> Source = MakeOrders(Count);
+
+    std::string Buffer;
+    auto        Report = [&](const char *Name, size_t Threads, const spdlog::stopwatch &Watch) {
+        const double Seconds = std::chrono::duration<double>(Watch.elapsed()).count();
+        spdlog::info("{:<19} {:>2} threads {:.4f}s, {:6.2f} M records/s, {:5.2f} GB/s", Name, Threads, Seconds,
+                     double(Count) / Seconds / 1e6, double(Buffer.size()) / Seconds / 1e9);
+    };
+
+    // untimed pass: buffer and records are faulted in before any measurement
+    std::vector<Order> Target;
+    REFL::BulkSerialize(Source, Buffer, 1);
+    REFL::BulkDeserialize(Target, Buffer, 1);
+    Target.clear();
+
+    {
+        spdlog::stopwatch Watch;
+        REFL::Serialize(Source, Buffer);
+        Report("vector serialize:", 1, Watch);
+    }
+    {
+        spdlog::stopwatch Watch;
+        REFL::Deserialize(Target, Buffer);
+        Report("vector deserialize:", 1, Watch);
+        Target.clear();
+    }
+
+    const size_t Hardware = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<size_t> ThreadCounts;
+    for (size_t Threads = 1; Threads < Hardware; Threads *= 2) {
+        ThreadCounts.push_back(Threads);
+    }
+    ThreadCounts.push_back(Hardware);
+
+    for (size_t Threads : ThreadCounts) {
+        {
+            spdlog::stopwatch Watch;
+            REFL::BulkSerialize(Source, Buffer, Threads);
+            Report("bulk serialize:", Threads, Watch);
+        }
+        {
+            // fresh records: allocation is part of decoding
+            Target.clear();
+            spdlog::stopwatch Watch;
+            REFL::BulkDeserialize(Target, Buffer, Threads);
+            Report("bulk deserialize:", Threads, Watch);
+        }
+    }
+
+    CHECK(Target.back().Symbol == Source.back().Symbol);
+}
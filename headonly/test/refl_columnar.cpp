@@ -0,0 +1,254 @@
+/*********************************************************************
+ * \file   refl_columnar.cpp
+ * \brief  memory mappable columnar files of reflected records
+ *         startup against full deserialization of the binary format
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/stopwatch.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <refl_binary.hpp>
+#include <refl_columnar.hpp>
+
+#include "records.hpp"
+
+namespace
+{
+
+struct Level {
+    uint32_t Price;
+    uint32_t Size;
+};
+
+class Position
+{
+public:
+    uint64_t    Account  = 0;
+    std::string Symbol;
+    double      Quantity = 0;
+    double      Price    = 0;
+    Level       Best{};
+    int32_t     Book     = 0;
+    bool        Active   = false;
+    std::string Desk;
+
+    MAKE_REFL(Position, Account, Symbol, Quantity, Price, Best, Book, Active, Desk);
+};
+
+// same member types, one renamed
+class RenamedPosition
+{
+public:
+    uint64_t    Account  = 0;
+    std::string Symbol;
+    double      Quantity = 0;
+    double      Price    = 0;
+    Level       Best{};
+    int32_t     Book     = 0;
+    bool        Enabled  = false;
+    std::string Desk;
+
+    MAKE_REFL(RenamedPosition, Account, Symbol, Quantity, Price, Best, Book, Enabled, Desk);
+};
+
+static_assert(REFL::SchemaFingerprint<Position>() != REFL::SchemaFingerprint<RenamedPosition>());
+static_assert(REFL::SchemaFingerprint<Position>() == REFL::SchemaFingerprint<const Position &>());
+
+std::vector<Position> MakePositions(size_t Count)
+{
+    std::vector<Position> Positions(Count);
+    for (size_t Index = 0; Index != Count; Index++) {
+        auto &Position    = Positions[Index];
+        Position.Account  = Index / 16;
+        Position.Symbol   = RECORDS::Symbol(Index);
+        Position.Quantity = double(Index % 300) - 150;
+        Position.Price    = RECORDS::Price(Index);
+        Position.Best     = Level{uint32_t(Index % 977), uint32_t(Index % 13)};
+        Position.Book     = int32_t(Index % 40);
+        Position.Active   = Index % 3 != 0;
+        Position.Desk     = Index % 7 == 0 ? "" : "equity derivatives";
+    }
+    return Positions;
+}
+
+std::string TempPath(const char *Name)
+{
+    return (std::filesystem::temp_directory_path() / Name).string();
+}
+
+} // namespace
+
+TEST_CASE("refl_columnar_round_trip")
+{
+    spdlog::info("--- --- --- refl_columnar_round_trip --- --- ---");
+
+    const std::vector<Position> Source = MakePositions(1000);
+
+    std::string Image;
+    REFL::ColumnarWrite(Source, Image);
+
+    const REFL::ColumnarView<Position> View(Image.data(), Image.size());
+    REQUIRE(View.size() == Source.size());
+
+    // typed columns, aligned, in visit order
+    constexpr size_t Price  = REFL::FieldIndex<Position>("Price");
+    constexpr size_t Symbol = REFL::FieldIndex<Position>("Symbol");
+    constexpr size_t Desk   = REFL::FieldIndex<Position>("Desk");
+
+    const auto Prices = View.Column<Price>();
+    CHECK((reinterpret_cast<const char *>(Prices.Data) - Image.data()) % REFL::SoaAlignment == 0);
+    CHECK(Prices[17] == Source[17].Price);
+    CHECK(View.Column<4>()[977].Price == Source[977].Best.Price);
+    CHECK(View.Column<Symbol>()[321] == Source[321].Symbol);
+    CHECK(View.Column<Desk>()[0].empty());
+    CHECK(View.Column<Desk>()[1] == "equity derivatives");
+
+    for (size_t Index : {size_t(0), size_t(1), size_t(999)}) {
+        const Position Row = View.Row(Index);
+        CHECK(Row.Account == Source[Index].Account);
+        CHECK(Row.Symbol == Source[Index].Symbol);
+        CHECK(Row.Best.Size == Source[Index].Best.Size);
+        CHECK(Row.Active == Source[Index].Active);
+        CHECK(Row.Desk == Source[Index].Desk);
+    }
+
+    // through the file mapping
+    const std::string Path = TempPath("refl_columnar_round_trip.col");
+    REFL::ColumnarSave(Source, Path);
+    {
+        const REFL::ColumnarFile<Position> File(Path);
+        CHECK(File.size() == Source.size());
+        CHECK(reinterpret_cast<uintptr_t>(File.Column<Price>().Data) % REFL::SoaAlignment == 0);
+        CHECK(File.Column<Symbol>()[999] == Source[999].Symbol);
+    }
+
+    // the schema of the reader must match the writer's
+    auto Rejects = [](auto Open) {
+        try {
+            Open();
+        }
+        catch (const REFL::ColumnarError &) {
+            return true;
+        }
+        return false;
+    };
+
+    CHECK(Rejects([&] { REFL::ColumnarFile<RenamedPosition> File(Path); }));
+    CHECK(Rejects([&] { REFL::ColumnarView<Position>(Image.data(), 100); }));
+    CHECK(Rejects([&] { REFL::ColumnarView<Position>(Image.data(), Image.size() - 64); }));
+    CHECK(Rejects([&] { REFL::ColumnarFile<Position> File(Path + ".missing"); }));
+
+    std::string Corrupt = Image;
+    Corrupt[0] ^= 1;
+    CHECK(Rejects([&] { REFL::ColumnarView<Position>(Corrupt.data(), Corrupt.size()); }));
+
+    // a row count that wraps the column sizes back to the real ones
+    Corrupt                = Image;
+    const uint64_t Wrapped = Source.size() + (uint64_t(1) << 61);
+    std::memcpy(Corrupt.data() + offsetof(REFL::DETAIL::ColumnarHeader, Rows), &Wrapped, sizeof(Wrapped));
+    CHECK(Rejects([&] { REFL::ColumnarView<Position>(Corrupt.data(), Corrupt.size()); }));
+
+    // interior string offsets past the blob and out of order: the view opens, the cells throw
+    Corrupt = Image;
+    REFL::DETAIL::ColumnarEntry Entry;
+    std::memcpy(&Entry, Corrupt.data() + sizeof(REFL::DETAIL::ColumnarHeader) + Symbol * sizeof(Entry),
+                sizeof(Entry));
+    uint64_t *Offsets = reinterpret_cast<uint64_t *>(Corrupt.data() + Entry.Offset);
+    Offsets[500]      = uint64_t(1) << 40;
+    Offsets[700]      = Offsets[701] + 1;
+    {
+        const REFL::ColumnarView<Position> Damaged(Corrupt.data(), Corrupt.size());
+        CHECK(Damaged.Column<Symbol>()[498] == Source[498].Symbol);
+        CHECK(Rejects([&] { return Damaged.Column<Symbol>()[500]; }));
+        CHECK(Rejects([&] { return Damaged.Column<Symbol>()[499]; }));
+        CHECK(Rejects([&] { return Damaged.Column<Symbol>()[700]; }));
+        CHECK(Rejects([&] { return Damaged.Row(500); }));
+    }
+
+    std::remove(Path.c_str());
+
+    // empty vector
+    std::string Empty;
+    REFL::ColumnarWrite(std::vector<Position>{}, Empty);
+    CHECK(REFL::ColumnarView<Position>(Empty.data(), Empty.size()).empty());
+}
+
+TEST_CASE("refl_columnar_benchmark")
+{
+    spdlog::info("--- --- --- refl_columnar_benchmark --- --- ---");
+
+    const size_t Count = 1UL << 21;
+
+    const std::string BinaryPath   = TempPath("refl_columnar_benchmark.bin");
+    const std::string ColumnarPath = TempPath("refl_columnar_benchmark.col");
+    {
+        const std::vector<Position> Source = MakePositions(Count);
+
+        std::string Buffer;
+        REFL::Serialize(Source, Buffer);
+        std::ofstream(BinaryPath, std::ios::binary).write(Buffer.data(), std::streamsize(Buffer.size()));
+
+        REFL::ColumnarSave(Source, ColumnarPath);
+
+        spdlog::info("binary file:   {:7.1f} MB", double(Buffer.size()) / 1e6);
+        spdlog::info("columnar file: {:7.1f} MB", double(std::filesystem::file_size(ColumnarPath)) / 1e6);
+    }
+
+    constexpr size_t Price = REFL::FieldIndex<Position>("Price");
+
+    // both files were just written: warm page cache, the cost is the decode
+    double Expected = 0;
+    {
+        spdlog::stopwatch Watch;
+
+        std::ifstream File(BinaryPath, std::ios::binary);
+        std::string   Buffer{std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>()};
+
+        std::vector<Position> Positions;
+        REFL::Deserialize(Positions, Buffer);
+        spdlog::info("binary load:            {:.4f}s", Watch);
+
+        for (auto &Position : Positions) {
+            Expected += Position.Price;
+        }
+        CHECK(Positions.size() == Count);
+    }
+    {
+        spdlog::stopwatch Watch;
+
+        const REFL::ColumnarFile<Position> File(ColumnarPath);
+        spdlog::info("columnar open:          {:.4f}s", Watch);
+
+        double Sum = 0;
+        for (double Value : File.Column<Price>()) {
+            Sum += Value;
+        }
+        spdlog::info("columnar open + scan:   {:.4f}s", Watch);
+        CHECK(Sum == Expected);
+
+        std::vector<Position> Positions;
+        Positions.reserve(File.size());
+        for (size_t Index = 0; Index != File.size(); Index++) {
+            Positions.push_back(File.Row(Index));
+        }
+        spdlog::info("columnar open + gather: {:.4f}s", Watch);
+        CHECK(Positions.back().Symbol == File.Column<1>()[Count - 1]);
+    }
+
+    std::remove(BinaryPath.c_str());
+    std::remove(ColumnarPath.c_str());
+}
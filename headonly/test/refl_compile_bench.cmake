@@ -0,0 +1,55 @@
+# Compile-time benchmark of refl.hpp
+#
+# Generates REFL_BENCH_UNITS translation units with REFL_BENCH_TYPES reflected types each,
+# alternating plain aggregates and MAKE_REFL classes of 1 .. REFL_BENCH_FIELDS members,
+# every type counted and visited once. Not part of the default build:
+#
+#   /usr/bin/time -v cmake --build <build> --target refl_compile_bench -j1
+#
+# and compare elapsed time / maximum resident set size across header changes, same CMAKE_BUILD_TYPE on both sides.
+
+set(REFL_BENCH_UNITS 4 CACHE STRING "refl compile bench: translation units")
+set(REFL_BENCH_TYPES 100 CACHE STRING "refl compile bench: reflected types per unit")
+set(REFL_BENCH_FIELDS 64 CACHE STRING "refl compile bench: max members per type")
+
+set(REFL_BENCH_MEMBER_TYPES "uint32_t" "double" "std::string" "uint8_t")
+set(REFL_BENCH_SOURCES)
+
+foreach(unit RANGE 1 ${REFL_BENCH_UNITS})
+    set(source "#include <cstdint>\n#include <string>\n\n#include <refl.hpp>\n\nnamespace bench_${unit}\n{\n")
+
+    foreach(type RANGE 1 ${REFL_BENCH_TYPES})
+        math(EXPR fields "1 + (${type} * 7 + ${unit}) % ${REFL_BENCH_FIELDS}")
+        math(EXPR last "${fields} - 1")
+        math(EXPR refl "${type} % 2")
+
+        set(members "")
+        set(names "")
+        foreach(field RANGE 0 ${last})
+            math(EXPR kind "${field} % 4")
+            list(GET REFL_BENCH_MEMBER_TYPES ${kind} member_type)
+            string(APPEND members "    ${member_type} f${field};\n")
+            string(APPEND names ", f${field}")
+        endforeach()
+
+        if(refl)
+            string(APPEND source "class T${type}\n{\npublic:\n${members}\n    MAKE_REFL(T${type}${names});\n};\n\n")
+        else()
+            string(APPEND source "struct T${type} {\n${members}};\n\n")
+        endif()
+
+        string(APPEND source "size_t touch(T${type} &Object)\n{\n"
+                             "    size_t Size = REFL::Counts<T${type}>();\n"
+                             "    REFL::Foreach(Object, [&](auto &&Member) { Size += sizeof(Member); });\n"
+                             "    return Size;\n}\n\n")
+    endforeach()
+
+    string(APPEND source "} // namespace bench_${unit}\n")
+
+    set(output "${CMAKE_CURRENT_BINARY_DIR}/refl_compile_bench_${unit}.cpp")
+    file(GENERATE OUTPUT "${output}" CONTENT "${source}")
+    list(APPEND REFL_BENCH_SOURCES "${output}")
+endforeach()
+
+add_library(refl_compile_bench OBJECT EXCLUDE_FROM_ALL ${REFL_BENCH_SOURCES})
+target_link_libraries(refl_compile_bench PRIVATE headonly)
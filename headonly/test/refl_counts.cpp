@@ -0,0 +1,207 @@
+/*********************************************************************
+ * \file   refl_counts.cpp
+ * \brief  member counting and visiting up to MaxClassMembers
+ *         for plain aggregates and MAKE_REFL types
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+
+#include <cstdint>
+#include <string>
+
+#include <refl.hpp>
+
+namespace
+{
+
+struct Empty {
+};
+
+struct Nested {
+    struct Inner {
+        int32_t A;
+        int32_t B;
+    };
+
+    Inner       First;
+    int32_t     Array[3];
+    std::string Name;
+};
+
+struct WideAggregate {
+    uint32_t F0;
+    uint32_t F1;
+    uint32_t F2;
+    uint32_t F3;
+    uint32_t F4;
+    uint32_t F5;
+    uint32_t F6;
+    uint32_t F7;
+    uint32_t F8;
+    uint32_t F9;
+    uint32_t F10;
+    uint32_t F11;
+    uint32_t F12;
+    uint32_t F13;
+    uint32_t F14;
+    uint32_t F15;
+    uint32_t F16;
+    uint32_t F17;
+    uint32_t F18;
+    uint32_t F19;
+    uint32_t F20;
+    uint32_t F21;
+    uint32_t F22;
+    uint32_t F23;
+    uint32_t F24;
+    uint32_t F25;
+    uint32_t F26;
+    uint32_t F27;
+    uint32_t F28;
+    uint32_t F29;
+    uint32_t F30;
+    uint32_t F31;
+    uint32_t F32;
+    uint32_t F33;
+    uint32_t F34;
+    uint32_t F35;
+    uint32_t F36;
+    uint32_t F37;
+    uint32_t F38;
+    uint32_t F39;
+    uint32_t F40;
+    uint32_t F41;
+    uint32_t F42;
+    uint32_t F43;
+    uint32_t F44;
+    uint32_t F45;
+    uint32_t F46;
+    uint32_t F47;
+    uint32_t F48;
+    uint32_t F49;
+    uint32_t F50;
+    uint32_t F51;
+    uint32_t F52;
+    uint32_t F53;
+    uint32_t F54;
+    uint32_t F55;
+    uint32_t F56;
+    uint32_t F57;
+    uint32_t F58;
+    uint32_t F59;
+    uint32_t F60;
+    uint32_t F61;
+    uint32_t F62;
+    uint32_t F63;
+};
+
+class Wide
+{
+public:
+    uint16_t M0 = 0;
+    uint16_t M1 = 1;
+    uint16_t M2 = 2;
+    uint16_t M3 = 3;
+    uint16_t M4 = 4;
+    uint16_t M5 = 5;
+    uint16_t M6 = 6;
+    uint16_t M7 = 7;
+    uint16_t M8 = 8;
+    uint16_t M9 = 9;
+    uint16_t M10 = 10;
+    uint16_t M11 = 11;
+    uint16_t M12 = 12;
+    uint16_t M13 = 13;
+    uint16_t M14 = 14;
+    uint16_t M15 = 15;
+    uint16_t M16 = 16;
+    uint16_t M17 = 17;
+    uint16_t M18 = 18;
+    uint16_t M19 = 19;
+    uint16_t M20 = 20;
+    uint16_t M21 = 21;
+    uint16_t M22 = 22;
+    uint16_t M23 = 23;
+    uint16_t M24 = 24;
+    uint16_t M25 = 25;
+    uint16_t M26 = 26;
+    uint16_t M27 = 27;
+    uint16_t M28 = 28;
+    uint16_t M29 = 29;
+    uint16_t M30 = 30;
+    uint16_t M31 = 31;
+    uint16_t M32 = 32;
+    uint16_t M33 = 33;
+    uint16_t M34 = 34;
+    uint16_t M35 = 35;
+    uint16_t M36 = 36;
+    uint16_t M37 = 37;
+    uint16_t M38 = 38;
+    uint16_t M39 = 39;
+    uint16_t M40 = 40;
+    uint16_t M41 = 41;
+    uint16_t M42 = 42;
+    uint16_t M43 = 43;
+    uint16_t M44 = 44;
+    uint16_t M45 = 45;
+    uint16_t M46 = 46;
+    uint16_t M47 = 47;
+    uint16_t M48 = 48;
+    uint16_t M49 = 49;
+    uint16_t M50 = 50;
+    uint16_t M51 = 51;
+    uint16_t M52 = 52;
+    uint16_t M53 = 53;
+    uint16_t M54 = 54;
+    uint16_t M55 = 55;
+    uint16_t M56 = 56;
+    uint16_t M57 = 57;
+    uint16_t M58 = 58;
+    uint16_t M59 = 59;
+    uint16_t M60 = 60;
+    uint16_t M61 = 61;
+    uint16_t M62 = 62;
+    uint16_t M63 = 63;
+
+    MAKE_REFL(Wide, M0, M1, M2, M3, M4, M5, M6, M7, M8, M9, M10, M11, M12, M13, M14, M15, M16, M17, M18, M19, M20, M21,
+              M22, M23, M24, M25, M26, M27, M28, M29, M30, M31, M32, M33, M34, M35, M36, M37, M38, M39, M40, M41, M42,
+              M43, M44, M45, M46, M47, M48, M49, M50, M51, M52, M53, M54, M55, M56, M57, M58, M59, M60, M61, M62, M63);
+};
+
+static_assert(REFL::Counts<Empty>() == 0);
+static_assert(REFL::Counts<Nested>() == 3);
+static_assert(REFL::Counts<WideAggregate>() == 64);
+static_assert(REFL::Counts<Wide>() == 64);
+
+} // namespace
+
+TEST_CASE("refl_counts_wide")
+{
+    spdlog::info("--- --- --- refl_counts_wide --- --- ---");
+
+    WideAggregate Aggregate{};
+    uint32_t      Value = 0;
+    REFL::Foreach(Aggregate, [&](auto &Member) { Member = Value++; });
+    CHECK(Aggregate.F0 == 0);
+    CHECK(Aggregate.F63 == 63);
+
+    const Wide Object;
+    size_t     Sum = 0, Index = 0;
+    bool       Ordered = true;
+    REFL::Foreach(Object, [&](const auto &Member) {
+        Ordered = Ordered && Member == Index++;
+        Sum += Member;
+    });
+    CHECK(Ordered);
+    CHECK(Sum == 2016);
+
+    // GET_NAME<I> counts from the last member, GET_NAME_I from the first
+    CHECK(std::string(Wide::REFL::GET_NAME<0>()) == "M63");
+    CHECK(std::string(Wide::REFL::GET_NAME_63()) == "M63");
+    CHECK(Wide::REFL::GET<63>(Object) == 0);
+    CHECK(Wide::REFL::GET_63(Object) == 63);
+}
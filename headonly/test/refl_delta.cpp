@@ -0,0 +1,252 @@
+/*********************************************************************
+ * \file   refl_delta.cpp
+ * \brief  dirty member tracking and delta replication of reflected state
+ *         bytes and encode time against full serialization, 1% / 10% / 50% churn
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/stopwatch.h>
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <refl_delta.hpp>
+#include <refl_field.hpp>
+
+namespace
+{
+
+class Leg
+{
+public:
+    uint64_t    Instrument = 0;
+    double      Ratio      = 1;
+    double      Price      = 0;
+    int32_t     Side       = 1;
+    std::string Venue      = "XNAS";
+
+    MAKE_REFL(Leg, Instrument, Ratio, Price, Side, Venue);
+};
+
+class Account
+{
+public:
+    std::string           Name    = "main";
+    double                Cash    = 0;
+    double                Margin  = 0;
+    uint64_t              Updated = 0;
+    std::vector<uint32_t> Limits  = std::vector<uint32_t>(8);
+
+    MAKE_REFL(Account, Name, Cash, Margin, Updated, Limits);
+};
+
+// 24 members, 92 leaves
+class Portfolio
+{
+public:
+    uint64_t               Id       = 0;
+    uint64_t               Sequence = 0;
+    std::string            Owner    = "desk 4";
+    double                 Value    = 0;
+    double                 Pnl      = 0;
+    double                 Exposure = 0;
+    std::vector<double>    Risk     = std::vector<double>(32);
+    REFL::Tracked<Account> Funding;
+    REFL::Tracked<Leg>     Leg0, Leg1, Leg2, Leg3, Leg4, Leg5, Leg6, Leg7;
+    REFL::Tracked<Leg>     Leg8, Leg9, Leg10, Leg11, Leg12, Leg13, Leg14, Leg15;
+
+    MAKE_REFL(Portfolio, Id, Sequence, Owner, Value, Pnl, Exposure, Risk, Funding, Leg0, Leg1, Leg2, Leg3, Leg4,
+              Leg5, Leg6, Leg7, Leg8, Leg9, Leg10, Leg11, Leg12, Leg13, Leg14, Leg15);
+};
+
+template <typename _Ty>
+void Bump(_Ty &Value)
+{
+    if constexpr (REFL::DETAIL::IsStringType<_Ty>) {
+        Value.back() = Value.back() == 'x' ? 'y' : 'x';
+    }
+    else if constexpr (REFL::DETAIL::IsContainerType<_Ty>) {
+        Value.front() += 1;
+    }
+    else {
+        Value += 1;
+    }
+}
+
+uint64_t Pick(std::mt19937_64 &Random, double Rate, size_t Count)
+{
+    std::bernoulli_distribution Draw(Rate);
+
+    uint64_t Mask = 0;
+    for (size_t Index = 0; Index != Count; Index++) {
+        Mask |= uint64_t(Draw(Random)) << Index;
+    }
+    return Mask;
+}
+
+template <typename _Ty, size_t... _I>
+void Churn(REFL::Tracked<_Ty> &State, std::mt19937_64 &Random, double Rate, std::index_sequence<_I...>);
+
+// each leaf changes with probability Rate; a nested object is touched only when one of its leaves is
+template <size_t _I, typename _Ty>
+void ChurnMember(REFL::Tracked<_Ty> &State, std::mt19937_64 &Random, double Rate, bool Picked)
+{
+    using Member = REFL::DETAIL::RemoveCVRType<decltype(State.template Get<_I>())>;
+
+    if constexpr (REFL::DETAIL::IsTracked<Member>) {
+        std::mt19937_64 Peek = Random;
+        if (Pick(Peek, Rate, Member::Count) != 0) {
+            Churn(State.template Modify<_I>(), Random, Rate, std::make_index_sequence<Member::Count>{});
+        }
+        else {
+            Random = Peek;
+        }
+    }
+    else if (Picked) {
+        Bump(State.template Modify<_I>());
+    }
+}
+
+template <typename _Ty, size_t... _I>
+void Churn(REFL::Tracked<_Ty> &State, std::mt19937_64 &Random, double Rate, std::index_sequence<_I...>)
+{
+    const uint64_t Mask = Pick(Random, Rate, sizeof...(_I));
+    (ChurnMember<_I>(State, Random, Rate, (Mask >> _I & 1) != 0), ...);
+}
+
+template <typename _Ty>
+std::string Full(const REFL::Tracked<_Ty> &State)
+{
+    std::string Buffer;
+    REFL::Serialize(State.Value(), Buffer);
+    return Buffer;
+}
+
+} // namespace
+
+TEST_CASE("refl_delta_tracking")
+{
+    spdlog::info("--- --- --- refl_delta_tracking --- --- ---");
+
+    // a Tracked member reflects as the wrapped type
+    static_assert(REFL::Counts<REFL::Tracked<Leg>>() == 5);
+    static_assert(REFL::FieldIndex<REFL::Tracked<Leg>>("Price") == 2);
+    static_assert(!REFL::IsPaddingFree<REFL::Tracked<Leg>>);
+
+    REFL::Tracked<Portfolio> State;
+    REFL::Tracked<Portfolio> Replica;
+    CHECK_FALSE(State.Dirty());
+
+    std::string Delta;
+    REFL::DeltaEncode(State, Delta);
+    CHECK(Delta.size() == 1);
+
+    State.Set<1>(uint64_t(42));
+    State.Modify<6>()[3] = 0.5;
+    State.Modify<REFL::FieldIndex<Portfolio>("Leg3")>().Set<2>(101.25);
+    CHECK(State.DirtyMask() == ((1u << 1) | (1u << 6) | (1u << 11)));
+    CHECK(State.Get<11>().DirtyMask() == (1u << 2));
+
+    // count, then index + value per member; the nested leg sends only its price
+    const size_t Expected = 1 + (1 + 8) + (1 + 4 + 32 * 8) + (1 + 1 + 1 + 8);
+    CHECK(REFL::DeltaSize(State) == Expected);
+
+    REFL::DeltaEncode(State, Delta);
+    CHECK(Delta.size() == Expected);
+    CHECK_FALSE(State.Dirty());
+    CHECK_FALSE(State.Get<11>().Dirty());
+
+    REFL::DeltaApply(Replica, Delta);
+    CHECK(Replica->Sequence == 42);
+    CHECK(Replica->Risk[3] == 0.5);
+    CHECK(Replica->Leg3->Price == 101.25);
+    CHECK(Full(Replica) == Full(State));
+
+    // the receiver marks what it applied, for relaying
+    CHECK(Replica.DirtyMask() == ((1u << 1) | (1u << 6) | (1u << 11)));
+    CHECK(Replica.Get<11>().DirtyMask() == (1u << 2));
+    Replica.Clean();
+
+    // new value: everything goes, nested objects in full
+    Portfolio Fresh;
+    Fresh.Owner = "desk 7";
+    State.Replace(Fresh);
+    CHECK(State.Get<8>().DirtyMask() == 0x1f);
+    REFL::DeltaEncode(State, Delta);
+    REFL::DeltaApply(Replica, Delta);
+    CHECK(Replica->Owner == "desk 7");
+    CHECK(Full(Replica) == Full(State));
+
+    // truncated input and bad member indexes
+    State.Modify<REFL::FieldIndex<Portfolio>("Funding")>().Set<0>(std::string("reserve"));
+    REFL::DeltaEncode(State, Delta);
+
+    bool Truncated = false;
+    try {
+        REFL::DeltaRead(Replica, Delta.data(), Delta.size() - 1);
+    }
+    catch (const std::out_of_range &) {
+        Truncated = true;
+    }
+    CHECK(Truncated);
+
+    const char BadIndex[] = {1, 30, 0};
+    bool       Rejected   = false;
+    try {
+        REFL::DeltaRead(Replica, BadIndex, sizeof(BadIndex));
+    }
+    catch (const std::out_of_range &) {
+        Rejected = true;
+    }
+    CHECK(Rejected);
+}
+
+TEST_CASE("refl_delta_benchmark")
+{
+    spdlog::info("--- --- --- refl_delta_benchmark --- --- ---");
+
+    const size_t Updates = 20000;
+
+    for (double Rate : {0.01, 0.10, 0.50}) {
+        std::mt19937_64          Random(7);
+        REFL::Tracked<Portfolio> State;
+        REFL::Tracked<Portfolio> Replica;
+
+        size_t FullBytes = 0, DeltaBytes = 0;
+        double FullTime = 0, DeltaTime = 0;
+
+        std::string FullBuffer, DeltaBuffer;
+        for (size_t Update = 0; Update != Updates; Update++) {
+            Churn(State, Random, Rate, std::make_index_sequence<REFL::Tracked<Portfolio>::Count>{});
+
+            auto Start = std::chrono::steady_clock::now();
+            REFL::Serialize(State.Value(), FullBuffer);
+            auto Stop = std::chrono::steady_clock::now();
+            FullTime += std::chrono::duration<double>(Stop - Start).count();
+            FullBytes += FullBuffer.size();
+
+            Start = std::chrono::steady_clock::now();
+            REFL::DeltaEncode(State, DeltaBuffer);
+            Stop = std::chrono::steady_clock::now();
+            DeltaTime += std::chrono::duration<double>(Stop - Start).count();
+            DeltaBytes += DeltaBuffer.size();
+
+            REFL::DeltaApply(Replica, DeltaBuffer);
+            Replica.Clean();
+        }
+
+        spdlog::info("churn {:4.0f}%: full {:7.1f} B {:6.0f} ns, delta {:7.1f} B {:6.0f} ns", Rate * 100,
+                     double(FullBytes) / Updates, FullTime / Updates * 1e9, double(DeltaBytes) / Updates,
+                     DeltaTime / Updates * 1e9);
+
+        CHECK(Full(Replica) == Full(State));
+        CHECK(DeltaBytes < FullBytes);
+    }
+}
@@ -0,0 +1,136 @@
+/*********************************************************************
+ * \file   refl_field.cpp
+ * \brief  runtime field access by index and name
+ *         perfect hash lookup against foreach + strcmp
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/stopwatch.h>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <refl_field.hpp>
+
+namespace
+{
+
+class Config
+{
+public:
+    uint32_t    Threads    = 8;
+    uint64_t    CacheBytes = 1 << 20;
+    double      Ratio      = 0.5;
+    std::string Host       = "localhost";
+    uint16_t    Port       = 8080;
+    bool        Verbose    = false;
+    int32_t     Retries    = 3;
+    float       Timeout    = 1.5f;
+    std::string User       = "root";
+    uint8_t     Level      = 2;
+
+    MAKE_REFL(Config, Threads, CacheBytes, Ratio, Host, Port, Verbose, Retries, Timeout, User, Level);
+};
+
+struct Point {
+    int32_t X;
+    int32_t Y;
+    double  Weight;
+};
+
+static_assert(REFL::FieldIndex<Config>("Threads") == 0);
+static_assert(REFL::FieldIndex<Config>("Level") == 9);
+static_assert(REFL::FieldIndex<Config>("Missing") == size_t(-1));
+
+// the lookup this replaces: walk the members and compare names
+void *LinearFind(Config &Object, const char *Name)
+{
+    const auto &Table = REFL::Fields<Config>();
+    void       *Found = nullptr;
+    size_t      Index = 0;
+
+    REFL::Foreach(Object, [&](auto &&Member) {
+        if (!Found && std::strcmp(Table[Index].Name.data(), Name) == 0) {
+            Found = &Member;
+        }
+        Index++;
+    });
+
+    return Found;
+}
+
+} // namespace
+
+TEST_CASE("refl_field_access")
+{
+    spdlog::info("--- --- --- refl_field_access --- --- ---");
+
+    Config Object;
+
+    const auto &Table = REFL::Fields<Config>();
+    REQUIRE(Table.size() == 10);
+    CHECK(Table[3].Name == "Host");
+    CHECK(Table[3].TypeId == REFL::TYPE_ID::STRING);
+    CHECK(Table[4].TypeId == REFL::TYPE_ID::WORD);
+    CHECK(Table[4].Size == sizeof(uint16_t));
+    CHECK(Table[4].Offset == size_t(reinterpret_cast<char *>(&Object.Port) - reinterpret_cast<char *>(&Object)));
+
+    *REFL::GetField(Object, "Port").As<uint16_t>() = 9090;
+    CHECK(Object.Port == 9090);
+
+    CHECK(*REFL::GetField(Object, 8).As<std::string>() == "root");
+    CHECK(REFL::GetField(Object, "Port").As<uint32_t>() == nullptr);
+    CHECK(!REFL::GetField(Object, "Missing"));
+    CHECK(!REFL::GetField(Object, 10));
+
+    const Config &Const = Object;
+    CHECK(*REFL::GetField(Const, "Ratio").As<double>() == 0.5);
+
+    // plain aggregates: index access only
+    Point Spot{1, 2, 3.0};
+    CHECK(*REFL::GetField(Spot, 1).As<int32_t>() == 2);
+    CHECK(REFL::Fields<Point>()[2].Offset == 8);
+}
+
+TEST_CASE("refl_field_benchmark")
+{
+    spdlog::info("--- --- --- refl_field_benchmark --- --- ---");
+
+    const size_t Lookups = 10000000;
+
+    Config                   Object;
+    std::vector<std::string> Names;
+    for (auto &Info : REFL::Fields<Config>()) {
+        Names.emplace_back(Info.Name);
+    }
+
+    std::mt19937        Engine(42);
+    std::vector<size_t> Queries(1 << 12);
+    for (auto &Query : Queries) {
+        Query = Engine() % Names.size();
+    }
+
+    size_t Found = 0;
+    {
+        spdlog::stopwatch Watch;
+        for (size_t Index = 0; Index != Lookups; Index++) {
+            Found += LinearFind(Object, Names[Queries[Index % Queries.size()]].c_str()) != nullptr;
+        }
+        spdlog::info("foreach + strcmp: {:.4f}s", Watch);
+    }
+    {
+        spdlog::stopwatch Watch;
+        for (size_t Index = 0; Index != Lookups; Index++) {
+            Found += bool(REFL::GetField(Object, Names[Queries[Index % Queries.size()]]));
+        }
+        spdlog::info("perfect hash:     {:.4f}s", Watch);
+    }
+
+    CHECK(Found == 2 * Lookups);
+}
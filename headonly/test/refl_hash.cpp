@@ -0,0 +1,313 @@
+/*********************************************************************
+ * \file   refl_hash.cpp
+ * \brief  member-wise hash and equality of reflected types
+ *         10M key insert / lookup against hash_combine over std::hash
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/stopwatch.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <refl_hash.hpp>
+
+namespace
+{
+
+// 16 bytes, no padding: one pass over the bytes
+struct OrderKey {
+    uint64_t Account;
+    uint32_t Venue;
+    uint32_t Symbol;
+
+    bool operator==(const OrderKey &Other) const
+    {
+        return Account == Other.Account && Venue == Other.Venue && Symbol == Other.Symbol;
+    }
+};
+
+static_assert(REFL::DETAIL::IsBytewise<OrderKey>);
+
+// padding after Side: member-wise
+struct PaddedKey {
+    uint64_t Account;
+    uint8_t  Side;
+};
+
+static_assert(!REFL::DETAIL::IsBytewise<PaddedKey>);
+
+class Instrument
+{
+public:
+    std::string                     Symbol;
+    double                          Strike = 0;
+    std::vector<uint32_t>           Legs;
+    std::unordered_set<std::string> Tags;
+
+    MAKE_REFL(Instrument, Symbol, Strike, Legs, Tags);
+};
+
+static_assert(!REFL::DETAIL::IsBytewise<Instrument>);
+
+// no operator==: unordered members compare through reflection too
+class Leg
+{
+public:
+    double  Ratio = 0;
+    int32_t Side  = 0;
+
+    MAKE_REFL(Leg, Ratio, Side);
+};
+
+class Strategy
+{
+public:
+    std::unordered_map<std::string, Leg> Legs;
+    std::unordered_multiset<int32_t>     Venues;
+
+    MAKE_REFL(Strategy, Legs, Venues);
+};
+
+// std::array members: bytes for integers, member-wise once a float is inside
+class Depth
+{
+public:
+    std::array<int32_t, 4> Levels{};
+    int32_t                Count = 0;
+
+    MAKE_REFL(Depth, Levels, Count);
+};
+
+struct Prices {
+    std::array<double, 2> Quote;
+    uint64_t              Id;
+};
+
+static_assert(REFL::DETAIL::IsBytewise<Depth>);
+static_assert(!REFL::DETAIL::IsBytewise<Prices>);
+
+// what one writes by hand without reflection
+inline void HashCombine(size_t &Seed, size_t Value)
+{
+    Seed ^= Value + 0x9e3779b9 + (Seed << 6) + (Seed >> 2);
+}
+
+struct OrderKeyHash {
+    size_t operator()(const OrderKey &Key) const
+    {
+        size_t Seed = 0;
+        HashCombine(Seed, std::hash<uint64_t>{}(Key.Account));
+        HashCombine(Seed, std::hash<uint32_t>{}(Key.Venue));
+        HashCombine(Seed, std::hash<uint32_t>{}(Key.Symbol));
+        return Seed;
+    }
+};
+
+// structured keys, as they come from a real book: few venues, dense symbols and accounts
+OrderKey MakeKey(size_t Index)
+{
+    return OrderKey{Index / 4096, uint32_t(Index % 8), uint32_t(Index / 8 % 512)};
+}
+
+} // namespace
+
+TEST_CASE("refl_hash_equal")
+{
+    spdlog::info("--- --- --- refl_hash_equal --- --- ---");
+
+    REFL::Hash<OrderKey>    KeyHash;
+    REFL::EqualTo<OrderKey> KeyEqual;
+
+    CHECK(KeyHash(OrderKey{1, 2, 3}) == KeyHash(OrderKey{1, 2, 3}));
+    CHECK(KeyHash(OrderKey{1, 2, 3}) != KeyHash(OrderKey{1, 3, 2}));
+    CHECK(KeyEqual(OrderKey{1, 2, 3}, OrderKey{1, 2, 3}));
+    CHECK_FALSE(KeyEqual(OrderKey{1, 2, 3}, OrderKey{1, 2, 4}));
+
+    // padding bytes never reach the hash
+    PaddedKey Left, Right;
+    std::memset(&Left, 0x00, sizeof(Left));
+    std::memset(&Right, 0xff, sizeof(Right));
+    Left.Account = Right.Account = 7;
+    Left.Side = Right.Side = 1;
+    CHECK(REFL::Hash<PaddedKey>{}(Left) == REFL::Hash<PaddedKey>{}(Right));
+    CHECK(REFL::EqualTo<PaddedKey>{}(Left, Right));
+
+    // strings, floating point and containers by value
+    Instrument First;
+    First.Symbol = "ES 2023-03 C 4000";
+    First.Strike = 0.0;
+    First.Legs   = {1, 2, 3};
+    First.Tags   = {"index", "future", "option", "cme"};
+
+    Instrument Second = First;
+    Second.Symbol     = std::string("ES 2023-03 C 4000");
+    Second.Strike     = -0.0;
+    Second.Tags.clear();
+    Second.Tags.rehash(64);
+    for (const char *Tag : {"cme", "option", "future", "index"}) {
+        Second.Tags.insert(Tag);
+    }
+
+    REFL::Hash<Instrument>    InstrumentHash;
+    REFL::EqualTo<Instrument> InstrumentEqual;
+    CHECK(InstrumentEqual(First, Second));
+    CHECK(InstrumentHash(First) == InstrumentHash(Second));
+
+    Second.Legs.push_back(4);
+    CHECK_FALSE(InstrumentEqual(First, Second));
+    CHECK(InstrumentHash(First) != InstrumentHash(Second));
+
+    Strategy Spread;
+    Spread.Legs   = {{"ESH3", Leg{1.0, 1}}, {"ESM3", Leg{-1.0, -1}}, {"ESU3", Leg{0.0, 1}}};
+    Spread.Venues = {1, 2, 2, 3};
+
+    Strategy Mirror;
+    Mirror.Legs.rehash(64);
+    Mirror.Legs.emplace("ESU3", Leg{-0.0, 1});
+    Mirror.Legs.emplace("ESM3", Leg{-1.0, -1});
+    Mirror.Legs.emplace("ESH3", Leg{1.0, 1});
+    Mirror.Venues = {3, 2, 1, 2};
+
+    REFL::Hash<Strategy>    StrategyHash;
+    REFL::EqualTo<Strategy> StrategyEqual;
+    CHECK(StrategyEqual(Spread, Mirror));
+    CHECK(StrategyHash(Spread) == StrategyHash(Mirror));
+
+    Mirror.Legs["ESM3"].Side = 1;
+    CHECK_FALSE(StrategyEqual(Spread, Mirror));
+    Mirror.Legs["ESM3"].Side = -1;
+    Mirror.Venues            = {1, 1, 2, 3};
+    CHECK_FALSE(StrategyEqual(Spread, Mirror));
+    Mirror.Venues = {1, 2, 2, 3};
+    Mirror.Legs.erase("ESH3");
+    Mirror.Legs.emplace("ESZ3", Leg{1.0, 1});
+    CHECK_FALSE(StrategyEqual(Spread, Mirror));
+
+    Depth Book;
+    Book.Levels = {4, 3, 2, 1};
+    Book.Count  = 4;
+    Depth Same  = Book;
+    CHECK(REFL::Hash<Depth>{}(Book) == REFL::Hash<Depth>{}(Same));
+    CHECK(REFL::EqualTo<Depth>{}(Book, Same));
+    Same.Levels[3] = 0;
+    CHECK_FALSE(REFL::EqualTo<Depth>{}(Book, Same));
+
+    CHECK(REFL::Hash<Prices>{}(Prices{{0.0, 1.5}, 9}) == REFL::Hash<Prices>{}(Prices{{-0.0, 1.5}, 9}));
+    CHECK(REFL::EqualTo<Prices>{}(Prices{{0.0, 1.5}, 9}, Prices{{-0.0, 1.5}, 9}));
+
+    // every length of the byte hash, including the 16 / 32 byte edges
+    std::string Text(100, 'x');
+    std::unordered_set<uint64_t> Seen;
+    for (size_t Length = 0; Length <= Text.size(); Length++) {
+        Seen.insert(REFL::DETAIL::HashBytes(Text.data(), Length));
+    }
+    CHECK(Seen.size() == Text.size() + 1);
+
+    for (size_t Length = 1; Length <= 64; Length++) {
+        std::string Flipped = Text.substr(0, Length);
+        const uint64_t Base = REFL::DETAIL::HashBytes(Flipped.data(), Length);
+        Flipped[Length - 1] = 'y';
+        CHECK(REFL::DETAIL::HashBytes(Flipped.data(), Length) != Base);
+        Flipped[Length - 1] = 'x';
+        Flipped[0]          = 'y';
+        CHECK(REFL::DETAIL::HashBytes(Flipped.data(), Length) != Base);
+    }
+}
+
+TEST_CASE("refl_hash_benchmark")
+{
+    spdlog::info("--- --- --- refl_hash_benchmark --- --- ---");
+
+    const size_t Count = 10'000'000;
+
+    std::vector<OrderKey> Keys(Count);
+    for (size_t Index = 0; Index != Count; Index++) {
+        Keys[Index] = MakeKey(Index);
+    }
+
+    // hash quality: full width collisions, and the longest chain of a power of two table on the low bits
+    auto Quality = [&](const char *Name, auto Hasher) {
+        std::vector<uint64_t> Hashes(Count);
+        for (size_t Index = 0; Index != Count; Index++) {
+            Hashes[Index] = Hasher(Keys[Index]);
+        }
+
+        const size_t          Mask = (size_t(1) << 24) - 1;
+        std::vector<uint32_t> Buckets(Mask + 1);
+        uint32_t              Longest = 0;
+        for (uint64_t Hash : Hashes) {
+            Longest = std::max(Longest, ++Buckets[Hash & Mask]);
+        }
+
+        std::sort(Hashes.begin(), Hashes.end());
+        const size_t Collisions = Count - size_t(std::unique(Hashes.begin(), Hashes.end()) - Hashes.begin());
+
+        spdlog::info("{:<18} collisions {:>8}, longest bucket {:>5}", Name, Collisions, Longest);
+        return Collisions;
+    };
+
+    CHECK(Quality("refl hash:", REFL::Hash<OrderKey>{}) == 0);
+    Quality("hash_combine:", OrderKeyHash{});
+
+    auto Workload = [&](const char *Name, auto Map) {
+        Map.reserve(Count);
+
+        // inserts in key order would favour hashes that keep neighbouring keys in neighbouring buckets
+        spdlog::stopwatch Watch;
+        for (size_t Index = 0; Index != Count; Index++) {
+            const size_t Shuffled = (Index * 104729) % Count;
+            Map.emplace(Keys[Shuffled], uint32_t(Shuffled));
+        }
+        const double Insert = std::chrono::duration<double>(Watch.elapsed()).count();
+
+        // lookups in a different order than the inserts, half of them miss
+        Watch.reset();
+        size_t Found = 0;
+        for (size_t Index = 0; Index != Count; Index++) {
+            const OrderKey &Key = Keys[(Index * 7919) % Count];
+            Found += Map.count(Index % 2 == 0 ? Key : OrderKey{Key.Account, Key.Venue + 8, Key.Symbol});
+        }
+        const double Lookup = std::chrono::duration<double>(Watch.elapsed()).count();
+
+        spdlog::info("{:<18} insert {:.4f}s, lookup {:.4f}s", Name, Insert, Lookup);
+        CHECK(Map.size() == Count);
+        CHECK(Found == Count / 2);
+    };
+
+    Workload("hash_combine:", std::unordered_map<OrderKey, uint32_t, OrderKeyHash>{});
+    Workload("refl hash:", std::unordered_map<OrderKey, uint32_t, REFL::Hash<OrderKey>, REFL::EqualTo<OrderKey>>{});
+
+    // member-wise: strings and floating point
+    const size_t            InstrumentCount = Count / 10;
+    std::vector<Instrument> Instruments(InstrumentCount);
+    for (size_t Index = 0; Index != InstrumentCount; Index++) {
+        Instruments[Index].Symbol = "OPT " + std::to_string(Index / 100) + " C " + std::to_string(Index % 100);
+        Instruments[Index].Strike = double(Index % 100) * 12.5;
+        Instruments[Index].Legs   = {uint32_t(Index), uint32_t(Index + 1)};
+    }
+
+    std::unordered_map<Instrument, uint32_t, REFL::Hash<Instrument>, REFL::EqualTo<Instrument>> Map;
+    Map.reserve(InstrumentCount);
+
+    spdlog::stopwatch Watch;
+    for (size_t Index = 0; Index != InstrumentCount; Index++) {
+        Map.emplace(Instruments[Index], uint32_t(Index));
+    }
+    size_t Found = 0;
+    for (size_t Index = 0; Index != InstrumentCount; Index++) {
+        Found += Map.count(Instruments[(Index * 7919) % InstrumentCount]);
+    }
+    spdlog::info("{:<18} insert + lookup {:.4f}s ({} keys)", "refl, string keys:", Watch, InstrumentCount);
+    CHECK(Found == InstrumentCount);
+}
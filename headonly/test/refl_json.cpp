@@ -0,0 +1,218 @@
+/*********************************************************************
+ * \file   refl_json.cpp
+ * \brief  json straight from / into reflected types
+ *         throughput against a round trip through a DOM (nlohmann::json,
+ *         when REFL_TEST_JSON_DOM is defined)
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/stopwatch.h>
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <refl_json.hpp>
+
+#include "records.hpp"
+
+#ifdef REFL_TEST_JSON_DOM
+#include <nlohmann/json.hpp>
+#endif
+
+namespace
+{
+
+using RECORDS::Order;
+
+class Book
+{
+public:
+    std::string                    Venue;
+    std::vector<Order>             Orders;
+    std::map<std::string, int32_t> Limits;
+
+    MAKE_REFL(Book, Venue, Orders, Limits);
+};
+
+// plain aggregate: positional array
+struct Level {
+    double   Price;
+    uint32_t Size;
+};
+
+class Snapshot
+{
+public:
+    std::array<Level, 2> Top{};
+    int64_t              Sequence = -1;
+    std::string          Comment  = "unchanged";
+
+    MAKE_REFL(Snapshot, Top, Sequence, Comment);
+};
+
+} // namespace
+
+#ifdef REFL_TEST_JSON_DOM
+// the DOM path this replaces, next to each type for ADL
+namespace RECORDS
+{
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Order, Id, Symbol, Price, Quantity, Buy, Tags, Note)
+} // namespace RECORDS
+
+namespace
+{
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Book, Venue, Orders, Limits)
+} // namespace
+#endif
+
+namespace
+{
+
+Book MakeBook(size_t Count)
+{
+    Book Book;
+    Book.Venue  = "XNAS";
+    Book.Limits = {{"AAPL", 100}, {"MSFT", -250}};
+    Book.Orders = RECORDS::MakeOrders(Count);
+    return Book;
+}
+
+} // namespace
+
+TEST_CASE("refl_json_round_trip")
+{
+    spdlog::info("--- --- --- refl_json_round_trip --- --- ---");
+
+    Book Source = MakeBook(20);
+    Source.Orders[1].Note = "quote \" slash \\ control \x01 utf-8 \xc3\xa9";
+
+    const std::string Text = REFL::ToJson(Source);
+    CHECK(Text.find("\"Venue\":\"XNAS\"") != std::string::npos);
+    CHECK(Text.find("\\u0001") != std::string::npos);
+
+    Book Target;
+    REFL::JsonRead(Target, Text);
+    CHECK(Target.Venue == Source.Venue);
+    CHECK(Target.Limits == Source.Limits);
+    REQUIRE(Target.Orders.size() == Source.Orders.size());
+    CHECK(Target.Orders[1].Note == Source.Orders[1].Note);
+    CHECK(Target.Orders[16].Note == Source.Orders[16].Note);
+    CHECK(Target.Orders[3].Tags == Source.Orders[3].Tags);
+    CHECK(Target.Orders[7].Price == Source.Orders[7].Price);
+
+#ifdef REFL_TEST_JSON_DOM
+    // same document as the DOM library writes
+    CHECK(nlohmann::json::parse(Text) == nlohmann::json(Source));
+#endif
+
+    // unknown keys are skipped, missing keys keep their value, escapes are decoded
+    Snapshot Snap;
+    REFL::JsonRead(Snap, R"( {
+        "Extra": {"a": [1, 2, {"b": "]}\"["}], "c": null},
+        "Top": [[10.5, 3], [11, 4]],
+        "Sequence": 42,
+        "Other": "x",
+        "Comment": "caf\u00e9 \ud83d\ude00"
+    } )");
+    CHECK(Snap.Top[1].Price == 11);
+    CHECK(Snap.Top[1].Size == 4);
+    CHECK(Snap.Sequence == 42);
+    CHECK(Snap.Comment == "caf\xc3\xa9 \xf0\x9f\x98\x80");
+
+    REFL::JsonRead(Snap, R"({"Extra": true, "Other": false, "More": -1.5e3, "Last": "\u00e9\n", "Sequence": 43})");
+    CHECK(Snap.Sequence == 43);
+
+    // skipped values are held to the same grammar as the ones read
+    for (const char *Bad : {R"({"Extra": nope})", R"({"Extra": 1-2e})", R"({"Extra": truth})", R"({"Extra": "\udc00"})",
+                            R"({"Extra": "\ud83dx"})", R"({"Extra": "\q"})", R"({"Comment": "\udc00"})"}) {
+        bool Rejected = false;
+        try {
+            REFL::JsonRead(Snap, Bad);
+        }
+        catch (const REFL::JsonError &) {
+            Rejected = true;
+        }
+        CHECK(Rejected);
+    }
+
+    Snapshot Partial;
+    REFL::JsonRead(Partial, R"({"Sequence": 7, "Comment": null})");
+    CHECK(Partial.Sequence == 7);
+    CHECK(Partial.Comment == "unchanged");
+    CHECK(REFL::ToJson(Partial) == R"({"Top":[[0,0],[0,0]],"Sequence":7,"Comment":"unchanged"})");
+
+    // errors carry the input offset
+    size_t Offset = 0;
+    try {
+        REFL::JsonRead(Partial, R"({"Sequence": 7x})");
+    }
+    catch (const REFL::JsonError &Error) {
+        Offset = Error.Offset;
+    }
+    CHECK(Offset == 14);
+
+    bool Thrown = false;
+    try {
+        REFL::JsonRead(Target, Text.substr(0, Text.size() - 1));
+    }
+    catch (const REFL::JsonError &) {
+        Thrown = true;
+    }
+    CHECK(Thrown);
+}
+
+TEST_CASE("refl_json_benchmark")
+{
+    spdlog::info("--- --- --- refl_json_benchmark --- --- ---");
+
+    const Book Source = MakeBook(1 << 18);
+
+    std::string Text;
+    Book        Target;
+
+    auto Report = [&](const char *Name, const spdlog::stopwatch &Watch) {
+        const double Seconds = std::chrono::duration<double>(Watch.elapsed()).count();
+        spdlog::info("{:<22} {:.4f}s, {:7.1f} MB/s", Name, Seconds, double(Text.size()) / Seconds / 1e6);
+    };
+
+    {
+        spdlog::stopwatch Watch;
+        REFL::JsonWrite(Source, Text);
+        Report("refl write:", Watch);
+    }
+    {
+        spdlog::stopwatch Watch;
+        REFL::JsonRead(Target, Text);
+        Report("refl read:", Watch);
+    }
+    {
+        // parsing over the previous result: elements and their strings are reused
+        spdlog::stopwatch Watch;
+        REFL::JsonRead(Target, Text);
+        Report("refl read, reused:", Watch);
+    }
+    CHECK(Target.Orders.back().Note == Source.Orders.back().Note);
+
+#ifdef REFL_TEST_JSON_DOM
+    std::string DomText;
+    {
+        spdlog::stopwatch Watch;
+        DomText = nlohmann::json(Source).dump();
+        Report("dom write:", Watch);
+    }
+    {
+        spdlog::stopwatch Watch;
+        Target = nlohmann::json::parse(DomText).get<Book>();
+        Report("dom read:", Watch);
+    }
+
+    CHECK(nlohmann::json::parse(DomText) == nlohmann::json::parse(Text));
+    CHECK(Target.Orders.size() == Source.Orders.size());
+#endif
+}
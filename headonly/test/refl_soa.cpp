@@ -0,0 +1,255 @@
+/*********************************************************************
+ * \file   refl_soa.cpp
+ * \brief  structure of arrays generated from reflected types
+ *         one-column scans against the std::vector of records
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/stopwatch.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <refl_soa.hpp>
+
+namespace
+{
+
+// 64 bytes: a scan of one field pulls the whole line through cache
+struct Trade {
+    uint64_t Id;
+    uint64_t Timestamp;
+    uint64_t Account;
+    uint64_t Order;
+    double   Price;
+    double   Fee;
+    uint32_t Quantity;
+    uint32_t Side;
+    uint32_t Venue;
+    uint32_t Flags;
+};
+
+static_assert(sizeof(Trade) == 64);
+
+class Quote
+{
+public:
+    std::string Symbol;
+    double      Bid   = 0;
+    double      Ask   = 0;
+    bool        Stale = false;
+
+    MAKE_REFL(Quote, Symbol, Bid, Ask, Stale);
+};
+
+// copies and moves may throw, on demand
+struct Fragile {
+    static inline bool Fail = false;
+
+    int Value = 0;
+
+    Fragile() = default;
+    Fragile(const Fragile &Other) : Value(Other.Value)
+    {
+        if (Fail) {
+            throw std::runtime_error("fragile copy");
+        }
+    }
+    Fragile(Fragile &&Other) : Fragile(static_cast<const Fragile &>(Other)) {}
+    Fragile &operator=(const Fragile &) = default;
+};
+
+class Tagged
+{
+public:
+    std::string Name;
+    Fragile     Payload;
+
+    MAKE_REFL(Tagged, Name, Payload);
+};
+
+Trade MakeTrade(size_t Index)
+{
+    return Trade{Index,
+                 1000 + Index,
+                 Index % 97,
+                 Index * 3,
+                 100.0 + double(Index % 1000) * 0.01,
+                 0.5,
+                 uint32_t(Index % 500),
+                 uint32_t(Index % 2),
+                 uint32_t(Index % 7),
+                 0};
+}
+
+} // namespace
+
+TEST_CASE("refl_soa_vector")
+{
+    spdlog::info("--- --- --- refl_soa_vector --- --- ---");
+
+    REFL::SoaVector<Quote> Quotes;
+    CHECK(Quotes.empty());
+
+    Quote First;
+    First.Symbol = "AAPL";
+    First.Bid    = 10.0;
+    First.Ask    = 10.5;
+    Quotes.push_back(First);
+    Quotes.emplace_back(std::string("MSFT"), 20.0, 20.25, true);
+    for (int Index = 0; Index != 100; Index++) {
+        Quotes.push_back(Quote{});
+    }
+    REQUIRE(Quotes.size() == 102);
+
+    // columns are aligned and hold the members in visit order
+    constexpr size_t Ask = REFL::FieldIndex<Quote>("Ask");
+    static_assert(std::is_same_v<REFL::SoaVector<Quote>::MemberType<Ask>, double>);
+    CHECK(reinterpret_cast<uintptr_t>(Quotes.Column<Ask>().Data) % REFL::SoaAlignment == 0);
+    CHECK(reinterpret_cast<uintptr_t>(Quotes.Column<3>().Data) % REFL::SoaAlignment == 0);
+    CHECK(Quotes.Column<0>()[1] == "MSFT");
+    CHECK(Quotes.Column<Ask>()[0] == 10.5);
+    CHECK(Quotes.Column<3>()[1]);
+
+    // proxy rows read and write through to the columns
+    Quotes[1].Get<1>() = 19.75;
+    CHECK(Quotes.Column<1>()[1] == 19.75);
+
+    Quote Copy = Quotes[1];
+    CHECK(Copy.Symbol == "MSFT");
+    CHECK(Copy.Bid == 19.75);
+
+    Quotes[2] = First;
+    Quotes[3] = Quotes[1];
+    CHECK(Quotes.Column<0>()[2] == "AAPL");
+    CHECK(Quotes.Column<0>()[3] == "MSFT");
+    CHECK(Quotes.Column<0>()[1] == "MSFT");
+
+    const auto &Const = Quotes;
+    CHECK(Const[3].Get<2>() == 20.25);
+
+    Quotes.pop_back();
+    CHECK(Quotes.size() == 101);
+
+    // plain aggregates work the same
+    REFL::SoaVector<Trade> Trades;
+    Trades.push_back(MakeTrade(7));
+    CHECK(Trades.Column<4>()[0] == MakeTrade(7).Price);
+    CHECK(Trade(Trades[0]).Order == 21);
+
+    // a failing push_back leaves the columns and the pushed record as they were
+    REFL::SoaVector<Tagged> Tags;
+    Tagged Record;
+    Record.Name = std::string(64, 'n');
+    Tags.push_back(Record);
+
+    Fragile::Fail = true;
+    bool Thrown   = false;
+    try {
+        Tags.push_back(std::move(Record));
+    }
+    catch (const std::runtime_error &) {
+        Thrown = true;
+    }
+    Fragile::Fail = false;
+    CHECK(Thrown);
+    CHECK(Tags.size() == 1);
+    CHECK(Record.Name == std::string(64, 'n'));
+
+    Tags.push_back(std::move(Record));
+    CHECK(Tags.size() == 2);
+    CHECK(Tags.Column<0>()[1] == std::string(64, 'n'));
+
+    REFL::SoaVector<Tagged> Duplicate = Tags;
+    CHECK(Duplicate.Column<0>()[0] == Tags.Column<0>()[0]);
+}
+
+TEST_CASE("refl_soa_benchmark")
+{
+    spdlog::info("--- --- --- refl_soa_benchmark --- --- ---");
+
+    const size_t Count = 1UL << 22;
+
+    std::vector<Trade>     Rows;
+    REFL::SoaVector<Trade> Columns;
+    Rows.reserve(Count);
+    Columns.reserve(Count);
+
+    {
+        spdlog::stopwatch Watch;
+        for (size_t Index = 0; Index != Count; Index++) {
+            Rows.push_back(MakeTrade(Index));
+        }
+        spdlog::info("aos fill:         {:.4f}s", Watch);
+    }
+    {
+        spdlog::stopwatch Watch;
+        for (size_t Index = 0; Index != Count; Index++) {
+            Columns.push_back(MakeTrade(Index));
+        }
+        spdlog::info("soa fill:         {:.4f}s", Watch);
+    }
+
+    // sum of one field
+    double AosSum = 0, SoaSum = 0;
+    {
+        spdlog::stopwatch Watch;
+        for (auto &Row : Rows) {
+            AosSum += Row.Price;
+        }
+        spdlog::info("aos sum price:    {:.4f}s", Watch);
+    }
+    {
+        spdlog::stopwatch Watch;
+        for (double Price : Columns.Column<4>()) {
+            SoaSum += Price;
+        }
+        spdlog::info("soa sum price:    {:.4f}s", Watch);
+    }
+
+    // filter on one field
+    size_t AosLarge = 0, SoaLarge = 0;
+    {
+        spdlog::stopwatch Watch;
+        for (auto &Row : Rows) {
+            AosLarge += Row.Quantity > 400;
+        }
+        spdlog::info("aos count filter: {:.4f}s", Watch);
+    }
+    {
+        spdlog::stopwatch Watch;
+        for (uint32_t Quantity : Columns.Column<6>()) {
+            SoaLarge += Quantity > 400;
+        }
+        spdlog::info("soa count filter: {:.4f}s", Watch);
+    }
+
+    // filter on one field, sum another
+    double AosBuy = 0, SoaBuy = 0;
+    {
+        spdlog::stopwatch Watch;
+        for (auto &Row : Rows) {
+            AosBuy += Row.Side == 1 ? Row.Price : 0.0;
+        }
+        spdlog::info("aos filter + sum: {:.4f}s", Watch);
+    }
+    {
+        spdlog::stopwatch Watch;
+        const auto        Side  = Columns.Column<7>();
+        const auto        Price = Columns.Column<4>();
+        for (size_t Index = 0; Index != Side.size(); Index++) {
+            SoaBuy += Side[Index] == 1 ? Price[Index] : 0.0;
+        }
+        spdlog::info("soa filter + sum: {:.4f}s", Watch);
+    }
+
+    CHECK(AosSum == SoaSum);
+    CHECK(AosLarge == SoaLarge);
+    CHECK(AosBuy == SoaBuy);
+}
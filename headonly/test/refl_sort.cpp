@@ -0,0 +1,240 @@
+/*********************************************************************
+ * \file   refl_sort.cpp
+ * \brief  multi-key radix sort over reflected members
+ *         10M records against std::sort and the parallel std::sort
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/stopwatch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#ifdef REFL_TEST_PARALLEL_SORT
+#include <execution>
+#endif
+
+#include <refl_field.hpp>
+#include <refl_sort.hpp>
+
+#include "records.hpp"
+
+namespace
+{
+
+enum class Venue : uint8_t { XNAS, XNYS, ARCX, BATS, IEXG };
+
+class Trade
+{
+public:
+    uint64_t    Id      = 0;
+    uint16_t    Account = 0;
+    double      Price   = 0;
+    int64_t     Time    = 0;
+    std::string Symbol;
+    Venue       Where = Venue::XNAS;
+
+    MAKE_REFL(Trade, Id, Account, Price, Time, Symbol, Where);
+};
+
+constexpr size_t ACCOUNT = REFL::FieldIndex<Trade>("Account");
+constexpr size_t PRICE   = REFL::FieldIndex<Trade>("Price");
+constexpr size_t TIME    = REFL::FieldIndex<Trade>("Time");
+constexpr size_t SYMBOL  = REFL::FieldIndex<Trade>("Symbol");
+constexpr size_t WHERE   = REFL::FieldIndex<Trade>("Where");
+
+std::vector<Trade> MakeTrades(size_t Count, uint32_t Seed)
+{
+    std::mt19937_64 Random(Seed);
+
+    std::vector<Trade> Trades(Count);
+    for (size_t Index = 0; Index != Count; Index++) {
+        auto &Trade   = Trades[Index];
+        Trade.Id      = Index;
+        Trade.Account = uint16_t(Random() % 2000);
+        Trade.Price   = double(int64_t(Random() % 200001) - 100000) * 0.01;
+        Trade.Time    = int64_t(Random() >> 1) - (int64_t(1) << 62);
+        Trade.Symbol  = RECORDS::Symbol(Random());
+        Trade.Where   = Venue(Random() % 5);
+    }
+    return Trades;
+}
+
+template <typename _Less>
+bool SameOrder(const std::vector<Trade> &Trades, const std::vector<uint32_t> &Order, _Less &&Less)
+{
+    std::vector<uint32_t> Expected(Trades.size());
+    for (size_t Index = 0; Index != Expected.size(); Index++) {
+        Expected[Index] = uint32_t(Index);
+    }
+    std::stable_sort(Expected.begin(), Expected.end(),
+                     [&](uint32_t Left, uint32_t Right) { return Less(Trades[Left], Trades[Right]); });
+    return Order == Expected;
+}
+
+} // namespace
+
+TEST_CASE("refl_sort_keys")
+{
+    spdlog::info("--- --- --- refl_sort_keys --- --- ---");
+
+    using REFL::DETAIL::SortKeyBits;
+
+    // key bits order like the values
+    CHECK(SortKeyBits(int32_t(-1)) < SortKeyBits(int32_t(0)));
+    CHECK(SortKeyBits(std::numeric_limits<int64_t>::min()) == 0);
+    CHECK(SortKeyBits(-2.5) < SortKeyBits(-1.0));
+    CHECK(SortKeyBits(-0.0) < SortKeyBits(0.0));
+    CHECK(SortKeyBits(1.0f) < SortKeyBits(std::numeric_limits<float>::infinity()));
+    CHECK(SortKeyBits(Venue::ARCX) == 2);
+
+    // strings: 7 bytes per group, the status byte ends the key
+    struct Named {
+        std::string Name;
+    };
+    std::vector<Named> Names{{"abcdefgh"}, {"abcdefg"}, {""}, {std::string(1, '\0')}, {"abcdefg"},
+                             {std::string(40, 'x')}, {std::string(39, 'x')}, {"ab"}, {"abcdefgi"}};
+
+    const std::vector<uint32_t> Order = REFL::RadixOrder(Names, 1);
+    std::vector<std::string>    Sorted;
+    for (uint32_t Index : Order) {
+        Sorted.push_back(Names[Index].Name);
+    }
+    CHECK(std::is_sorted(Sorted.begin(), Sorted.end()));
+    CHECK(Order[3] == 1);
+    CHECK(Order[4] == 4);
+}
+
+TEST_CASE("refl_sort_order")
+{
+    spdlog::info("--- --- --- refl_sort_order --- --- ---");
+
+    // many blocks and duplicate keys, sorted on 1 and 4 threads
+    std::vector<Trade> Trades = MakeTrades(300000, 7);
+    for (size_t Index = 0; Index != Trades.size(); Index += 3) {
+        Trades[Index].Price = -0.5;
+    }
+    for (size_t Index = 0; Index != Trades.size(); Index += 5) {
+        Trades[Index].Symbol =
+            Index % 2 ? "" : "A LONG SYMBOL NAME THAT SPANS SEVERAL KEY GROUPS " + std::to_string(Index % 7);
+    }
+
+    for (size_t Threads : {size_t(1), size_t(4)}) {
+        CHECK(SameOrder(Trades, REFL::RadixOrder<TIME>(Trades, Threads),
+                        [](const Trade &Left, const Trade &Right) { return Left.Time < Right.Time; }));
+
+        CHECK(SameOrder(Trades, REFL::RadixOrder<PRICE>(Trades, Threads),
+                        [](const Trade &Left, const Trade &Right) { return Left.Price < Right.Price; }));
+
+        CHECK(SameOrder(Trades, REFL::RadixOrder<ACCOUNT, PRICE>(Trades, Threads),
+                        [](const Trade &Left, const Trade &Right) {
+                            return std::tie(Left.Account, Left.Price) < std::tie(Right.Account, Right.Price);
+                        }));
+
+        CHECK(SameOrder(Trades, REFL::RadixOrder<SYMBOL, TIME>(Trades, Threads),
+                        [](const Trade &Left, const Trade &Right) {
+                            return std::tie(Left.Symbol, Left.Time) < std::tie(Right.Symbol, Right.Time);
+                        }));
+
+        CHECK(SameOrder(Trades, REFL::RadixOrder<WHERE, SYMBOL, ACCOUNT>(Trades, Threads),
+                        [](const Trade &Left, const Trade &Right) {
+                            return std::tie(Left.Where, Left.Symbol, Left.Account) <
+                                   std::tie(Right.Where, Right.Symbol, Right.Account);
+                        }));
+    }
+
+    // all members: Id is unique, records come out in their original order
+    const std::vector<uint32_t> Order = REFL::RadixOrder(Trades, 4);
+    CHECK(std::is_sorted(Order.begin(), Order.end()));
+
+    // records moved into order
+    std::vector<Trade> Sorted = Trades;
+    REFL::RadixSort<SYMBOL, TIME>(Sorted, 4);
+    CHECK(std::is_sorted(Sorted.begin(), Sorted.end(), [](const Trade &Left, const Trade &Right) {
+        return std::tie(Left.Symbol, Left.Time) < std::tie(Right.Symbol, Right.Time);
+    }));
+    CHECK(Sorted.size() == Trades.size());
+
+    std::vector<Trade> Empty;
+    REFL::RadixSort<TIME>(Empty, 4);
+    CHECK(REFL::RadixOrder<TIME>(Empty, 4).empty());
+}
+
+TEST_CASE("refl_sort_benchmark")
+{
+    spdlog::info("--- --- --- refl_sort_benchmark --- --- ---");
+
+    const size_t             Count   = 10'000'000;
+    const size_t             Threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::vector<Trade> Source  = MakeTrades(Count, 42);
+
+    auto Report = [&](const char *Key, const char *Name, const spdlog::stopwatch &Watch) {
+        const double Seconds = std::chrono::duration<double>(Watch.elapsed()).count();
+        spdlog::info("{:<16} {:<22} {:.4f}s, {:6.2f} M records/s", Key, Name, Seconds, double(Count) / Seconds / 1e6);
+    };
+
+    auto Bench = [&](const char *Key, auto &&RadixOrder, auto &&RadixSort, auto &&Less) {
+        {
+            spdlog::stopwatch Watch;
+            const auto        Order = RadixOrder();
+            Report(Key, "radix order:", Watch);
+            CHECK(Order.size() == Count);
+        }
+
+        std::vector<Trade> Records = Source;
+        {
+            spdlog::stopwatch Watch;
+            RadixSort(Records);
+            Report(Key, "radix sort:", Watch);
+        }
+        CHECK(std::is_sorted(Records.begin(), Records.end(), Less));
+
+        Records = Source;
+        {
+            spdlog::stopwatch Watch;
+            std::sort(Records.begin(), Records.end(), Less);
+            Report(Key, "std::sort:", Watch);
+        }
+
+#ifdef REFL_TEST_PARALLEL_SORT
+        Records = Source;
+        {
+            spdlog::stopwatch Watch;
+            std::sort(std::execution::par, Records.begin(), Records.end(), Less);
+            Report(Key, "std::sort par:", Watch);
+        }
+#endif
+    };
+
+    spdlog::info("{} records, {} threads", Count, Threads);
+
+    Bench(
+        "int64:", [&] { return REFL::RadixOrder<TIME>(Source, Threads); },
+        [&](std::vector<Trade> &Records) { REFL::RadixSort<TIME>(Records, Threads); },
+        [](const Trade &Left, const Trade &Right) { return Left.Time < Right.Time; });
+
+    Bench(
+        "uint16, double:", [&] { return REFL::RadixOrder<ACCOUNT, PRICE>(Source, Threads); },
+        [&](std::vector<Trade> &Records) { REFL::RadixSort<ACCOUNT, PRICE>(Records, Threads); },
+        [](const Trade &Left, const Trade &Right) {
+            return std::tie(Left.Account, Left.Price) < std::tie(Right.Account, Right.Price);
+        });
+
+    Bench(
+        "string, int64:", [&] { return REFL::RadixOrder<SYMBOL, TIME>(Source, Threads); },
+        [&](std::vector<Trade> &Records) { REFL::RadixSort<SYMBOL, TIME>(Records, Threads); },
+        [](const Trade &Left, const Trade &Right) {
+            return std::tie(Left.Symbol, Left.Time) < std::tie(Right.Symbol, Right.Time);
+        });
+}
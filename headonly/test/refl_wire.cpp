@@ -0,0 +1,369 @@
+/*********************************************************************
+ * \file   refl_wire.cpp
+ * \brief  compact tagged wire format, varint / zigzag and field skipping
+ *         size and decode speed against the fixed width binary format
+ *
+ * \author starshore
+ * \date   January 2023
+ *********************************************************************/
+
+#include <doctest/doctest.h>
+#include <spdlog/spdlog.h>
+#include <spdlog/stopwatch.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <refl_binary.hpp>
+#include <refl_wire.hpp>
+
+#include "records.hpp"
+
+namespace
+{
+
+enum class Side : int8_t
+{
+    BUY  = 1,
+    SELL = -1,
+};
+
+struct Level {
+    int32_t  Price;
+    uint32_t Size;
+};
+
+struct Pair {
+    uint32_t A;
+    int32_t  B;
+};
+
+// mostly small integers: ids, venues, prices in ticks around a reference, sizes
+class Quote
+{
+public:
+    uint64_t              Id        = 0;
+    uint32_t              Venue     = 0;
+    int32_t               Bid       = 0;
+    int32_t               Ask       = 0;
+    uint32_t              BidSize   = 0;
+    uint32_t              AskSize   = 0;
+    Side                  Direction = Side::BUY;
+    bool                  Firm      = false;
+    double                Reference = 0;
+    std::string           Symbol;
+    std::vector<uint32_t> Orders;
+    Level                 Best{};
+
+    MAKE_REFL(Quote, Id, Venue, Bid, Ask, BidSize, AskSize, Direction, Firm, Reference, Symbol, Orders, Best);
+};
+
+class Mixed
+{
+public:
+    std::vector<uint64_t>           Unsigned;
+    std::vector<int64_t>            Signed;
+    std::vector<double>             Doubles;
+    std::vector<std::string>        Names;
+    std::map<std::string, int32_t>  Limits;
+    std::set<int16_t>               Keys;
+    std::array<float, 3>            Weights{};
+    int32_t                         Grid[3]{};
+    std::wstring                    Title;
+    std::vector<std::vector<Level>> Ladders;
+
+    MAKE_REFL(Mixed, Unsigned, Signed, Doubles, Names, Limits, Keys, Weights, Grid, Title, Ladders);
+};
+
+//
+// one message across three schema versions
+//
+
+class OrderV1
+{
+public:
+    uint64_t    Id = 0;
+    std::string Symbol;
+    int32_t     Quantity = 0;
+
+    MAKE_REFL(OrderV1, Id, Symbol, Quantity);
+};
+
+// two members appended
+class OrderV2
+{
+public:
+    uint64_t    Id = 0;
+    std::string Symbol;
+    int32_t     Quantity = 0;
+    double      Price    = 0;
+    Quote       Origin;
+
+    MAKE_REFL(OrderV2, Id, Symbol, Quantity, Price, Origin);
+};
+
+// Quantity changed its type
+class OrderV3
+{
+public:
+    uint64_t    Id = 0;
+    std::string Symbol;
+    std::string Quantity;
+
+    MAKE_REFL(OrderV3, Id, Symbol, Quantity);
+};
+
+std::vector<Quote> MakeQuotes(size_t Count)
+{
+    std::mt19937_64 Random(11);
+
+    std::vector<Quote> Quotes(Count);
+    for (size_t Index = 0; Index != Count; Index++) {
+        auto &Quote     = Quotes[Index];
+        Quote.Id        = Index;
+        Quote.Venue     = uint32_t(Random() % 12);
+        Quote.Bid       = int32_t(Random() % 200) - 100;
+        Quote.Ask       = Quote.Bid + 1 + int32_t(Random() % 4);
+        Quote.BidSize   = uint32_t(Random() % 500);
+        Quote.AskSize   = uint32_t(Random() % 20000);
+        Quote.Direction = Random() % 2 ? Side::BUY : Side::SELL;
+        Quote.Firm      = Random() % 4 != 0;
+        Quote.Reference = RECORDS::Price(Index);
+        Quote.Symbol    = RECORDS::Symbol(Index);
+        Quote.Orders.resize(Random() % 4);
+        for (auto &Order : Quote.Orders) {
+            Order = uint32_t(Random() % 1000);
+        }
+        Quote.Best = Level{Quote.Bid, Quote.BidSize};
+    }
+    return Quotes;
+}
+
+bool Rejects(const std::string &Buffer)
+{
+    Quote Target;
+    try {
+        REFL::WireDecode(Target, Buffer);
+    }
+    catch (const std::out_of_range &) {
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("refl_wire_round_trip")
+{
+    spdlog::info("--- --- --- refl_wire_round_trip --- --- ---");
+
+    // tag (index << 3 | kind), LEB128, zigzag
+    std::string Buffer;
+    REFL::WireEncode(Pair{300, -1}, Buffer);
+    CHECK(Buffer == std::string("\x00\xac\x02\x08\x01", 5));
+
+    REFL::WireEncode(Pair{0, -64}, Buffer);
+    CHECK(Buffer == std::string("\x00\x00\x08\x7f", 4));
+
+    for (uint64_t Value : {uint64_t(0), uint64_t(127), uint64_t(128), uint64_t(16383), uint64_t(16384),
+                           (uint64_t(1) << 56) - 1, uint64_t(1) << 56, uint64_t(1) << 63,
+                           std::numeric_limits<uint64_t>::max()}) {
+        char Encoded[10];
+        char *Cursor = Encoded;
+        REFL::DETAIL::WriteVarint(Cursor, Value);
+        CHECK(size_t(Cursor - Encoded) == REFL::DETAIL::VarintSize(Value));
+    }
+
+    Mixed Source;
+    Source.Unsigned = {0, 127, 128, (uint64_t(1) << 56) - 1, uint64_t(1) << 56, std::numeric_limits<uint64_t>::max()};
+    Source.Signed   = {0, -1, 1, -64, 64, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()};
+    Source.Doubles  = {0.5, -2.25};
+    Source.Names    = {"", "alpha", std::string(300, 'x')};
+    Source.Limits   = {{"gross", -5}, {"net", 70000}};
+    Source.Keys     = {-3, 9, 1000};
+    Source.Weights  = {0.25f, 0.5f, 0.25f};
+    Source.Grid[0]  = -7;
+    Source.Grid[2]  = 7;
+    Source.Title    = L"wide title";
+    Source.Ladders  = {{{1, 2}, {-3, 4}}, {}, {{5, 6}}};
+
+    REFL::WireEncode(Source, Buffer);
+    CHECK(Buffer.size() == REFL::WireSize(Source));
+
+    Mixed Target;
+    Target.Names = {"reused", "reused", "reused", "reused", "dropped"};
+    REFL::WireDecode(Target, Buffer);
+    CHECK(Target.Unsigned == Source.Unsigned);
+    CHECK(Target.Signed == Source.Signed);
+    CHECK(Target.Doubles == Source.Doubles);
+    CHECK(Target.Names == Source.Names);
+    CHECK(Target.Limits == Source.Limits);
+    CHECK(Target.Keys == Source.Keys);
+    CHECK(Target.Weights == Source.Weights);
+    CHECK(Target.Grid[0] == -7);
+    CHECK(Target.Grid[2] == 7);
+    CHECK(Target.Title == Source.Title);
+    REQUIRE(Target.Ladders.size() == 3);
+    CHECK(Target.Ladders[0][1].Price == -3);
+    CHECK(Target.Ladders[1].empty());
+    CHECK(Target.Ladders[2][0].Size == 6);
+
+    // schema drift: unknown members are skipped, missing ones keep their value
+    OrderV2 Newer;
+    Newer.Id             = 77;
+    Newer.Symbol         = "ABC";
+    Newer.Quantity       = -300;
+    Newer.Price          = 10.5;
+    Newer.Origin         = MakeQuotes(1)[0];
+    Newer.Origin.Symbol  = "nested";
+    REFL::WireEncode(Newer, Buffer);
+
+    OrderV1 Older;
+    REFL::WireDecode(Older, Buffer);
+    CHECK(Older.Id == 77);
+    CHECK(Older.Symbol == "ABC");
+    CHECK(Older.Quantity == -300);
+
+    OrderV2 Upgraded;
+    Upgraded.Price = 1.5;
+    REFL::WireEncode(Older, Buffer);
+    REFL::WireDecode(Upgraded, Buffer);
+    CHECK(Upgraded.Quantity == -300);
+    CHECK(Upgraded.Price == 1.5);
+
+    // a changed kind is skipped like an unknown member
+    OrderV3 Retyped;
+    Retyped.Quantity = "unchanged";
+    REFL::WireDecode(Retyped, Buffer);
+    CHECK(Retyped.Id == 77);
+    CHECK(Retyped.Quantity == "unchanged");
+
+    // any member order decodes
+    REFL::WireEncode(Pair{5, 6}, Buffer);
+    Pair Swapped{};
+    REFL::WireDecode(Swapped, Buffer.substr(2) + Buffer.substr(0, 2));
+    CHECK(Swapped.A == 5);
+    CHECK(Swapped.B == 6);
+
+    // malformed input
+    const std::vector<Quote> Quotes = MakeQuotes(2);
+    REFL::WireEncode(Quotes[1], Buffer);
+    CHECK_FALSE(Rejects(Buffer));
+    CHECK(Rejects(Buffer.substr(0, Buffer.size() - 1)));
+    CHECK(Rejects(std::string("\x03", 1)));
+    CHECK(Rejects(std::string("\x00\xff\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01", 12)));
+}
+
+TEST_CASE("refl_wire_benchmark")
+{
+    spdlog::info("--- --- --- refl_wire_benchmark --- --- ---");
+
+    const size_t             Count  = 1UL << 20;
+    const std::vector<Quote> Source = MakeQuotes(Count);
+
+    std::string        Fixed, Wire;
+    std::vector<Quote> Target;
+
+    // untimed pass: buffers and records are faulted in
+    REFL::Serialize(Source, Fixed);
+    REFL::WireEncode(Source, Wire);
+    REFL::Deserialize(Target, Fixed);
+    REFL::WireDecode(Target, Wire);
+
+    spdlog::info("fixed width: {:6.1f} B/record", double(Fixed.size()) / Count);
+    spdlog::info("wire:        {:6.1f} B/record", double(Wire.size()) / Count);
+    CHECK(Wire.size() < Fixed.size());
+
+    auto Report = [&](const char *Name, const spdlog::stopwatch &Watch, size_t Bytes) {
+        const double Seconds = std::chrono::duration<double>(Watch.elapsed()).count();
+        spdlog::info("{:<19} {:.4f}s, {:6.2f} M records/s, {:5.2f} GB/s", Name, Seconds,
+                     double(Count) / Seconds / 1e6, double(Bytes) / Seconds / 1e9);
+    };
+
+    {
+        spdlog::stopwatch Watch;
+        REFL::Serialize(Source, Fixed);
+        Report("fixed encode:", Watch, Fixed.size());
+    }
+    {
+        spdlog::stopwatch Watch;
+        REFL::WireEncode(Source, Wire);
+        Report("wire encode:", Watch, Wire.size());
+    }
+    {
+        spdlog::stopwatch Watch;
+        REFL::Deserialize(Target, Fixed);
+        Report("fixed decode:", Watch, Fixed.size());
+    }
+    {
+        spdlog::stopwatch Watch;
+        REFL::WireDecode(Target, Wire);
+        Report("wire decode:", Watch, Wire.size());
+    }
+    CHECK(Target.back().Symbol == Source.back().Symbol);
+    CHECK(Target.back().Bid == Source.back().Bid);
+
+    // the varint decoder alone: 1 to 5 byte values, unpredictable lengths
+    std::mt19937_64       Random(5);
+    std::vector<uint64_t> Values(1UL << 22);
+    for (auto &Value : Values) {
+        Value = Random() >> (64 - 7 * (1 + Random() % 5));
+    }
+
+    std::string Packed(Values.size() * 10, '\0');
+    char       *Cursor = Packed.data();
+    for (auto Value : Values) {
+        REFL::DETAIL::WriteVarint(Cursor, Value);
+    }
+    Packed.resize(size_t(Cursor - Packed.data()));
+
+    auto Decode = [&](const char *Name, auto Next) {
+        REFL::DETAIL::WireReader Reader{Packed.data(), Packed.data() + Packed.size()};
+
+        spdlog::stopwatch Watch;
+        uint64_t          Sum = 0;
+        while (!Reader.Empty()) {
+            Sum += Next(Reader);
+        }
+        const double Seconds = std::chrono::duration<double>(Watch.elapsed()).count();
+        spdlog::info("{:<19} {:.4f}s, {:6.2f} ns/varint", Name, Seconds, Seconds / double(Values.size()) * 1e9);
+        return Sum;
+    };
+
+    const uint64_t Word     = Decode("varint word:", [](auto &Reader) { return Reader.Varint(); });
+    const uint64_t Bytewise = Decode("varint bytewise:", [](auto &Reader) { return Reader.VarintBytewise(); });
+    CHECK(Word == Bytewise);
+    CHECK(REFL::DETAIL::CountVarints(Packed.data(), Packed.size()) == Values.size());
+
+    // packed small integers, one in ten above 127: SSE2 takes the one byte runs
+    std::vector<uint32_t> Small(1UL << 24);
+    for (auto &Value : Small) {
+        Value = Random() % 10 == 0 ? uint32_t(Random() % 100000) : uint32_t(Random() % 128);
+    }
+
+    std::string           FixedSmall, WireSmall;
+    std::vector<uint32_t> Decoded;
+    REFL::Serialize(Small, FixedSmall);
+    REFL::WireEncode(Small, WireSmall);
+    REFL::Deserialize(Decoded, FixedSmall);
+
+    spdlog::info("packed fixed:        {:6.1f} MB", double(FixedSmall.size()) / 1e6);
+    spdlog::info("packed wire:         {:6.1f} MB", double(WireSmall.size()) / 1e6);
+    {
+        spdlog::stopwatch Watch;
+        REFL::Deserialize(Decoded, FixedSmall);
+        spdlog::info("packed fixed decode: {:.4f}s", Watch);
+    }
+    {
+        spdlog::stopwatch Watch;
+        REFL::WireDecode(Decoded, WireSmall);
+        spdlog::info("packed wire decode:  {:.4f}s", Watch);
+    }
+    CHECK(Decoded == Small);
+}